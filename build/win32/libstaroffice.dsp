@@ -115,6 +115,10 @@ SOURCE=..\..\src\lib\STOFFCellStyle.cxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\STOFFCSVSpreadsheetGenerator.cxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\STOFFChart.cxx
 # End Source File
 # Begin Source File
@@ -227,6 +231,10 @@ SOURCE=..\..\src\lib\STOFFTable.cxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\STOFFTextExtractor.cxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\STOFFTextListener.cxx
 # End Source File
 # Begin Source File
@@ -427,6 +435,10 @@ SOURCE=..\..\src\lib\STOFFCellStyle.hxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\STOFFCSVSpreadsheetGenerator.hxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\STOFFChart.hxx
 # End Source File
 # Begin Source File
@@ -535,6 +547,10 @@ SOURCE=..\..\src\lib\STOFFTable.hxx
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\src\lib\STOFFTextExtractor.hxx
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\src\lib\STOFFTextListener.hxx
 # End Source File
 # Begin Source File
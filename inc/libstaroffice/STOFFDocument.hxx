@@ -44,6 +44,8 @@ namespace librevenge
 class RVNGBinaryData;
 class RVNGDrawingInterface;
 class RVNGPresentationInterface;
+class RVNGPropertyList;
+class RVNGPropertyListVector;
 class RVNGSpreadsheetInterface;
 class RVNGTextInterface;
 class RVNGInputStream;
@@ -82,7 +84,90 @@ public:
     STOFF_R_OLE_ERROR /** problem when reading the OLE structure*/,
     STOFF_R_PARSE_ERROR /** problem when parsing the file*/,
     STOFF_R_PASSWORD_MISSMATCH_ERROR /** problem when using the given password*/,
-    STOFF_R_UNKNOWN_ERROR /** unknown error*/
+    STOFF_R_UNKNOWN_ERROR /** unknown error*/,
+    STOFF_R_ABORTED /** the parsing was stopped: deadline reached, allocation budget exhausted or cancellation, see ParseOptions*/
+  };
+
+  /** a structure used to define the parsing options, see parse.
+
+   When a limit is reached, the parsing is stopped and STOFF_R_ABORTED is returned; the data already
+   sent to the interface are not removed. */
+  struct ParseOptions {
+    //! constructor
+    ParseOptions()
+      : m_password(0)
+      , m_skipPictures(false)
+      , m_progressive(false)
+      , m_useThreads(false)
+      , m_maxDuration(0)
+      , m_maxAllocationSize(0)
+      , m_cancelCallback(0)
+      , m_cancelData(0)
+    {
+    }
+    //! the file password
+    char const *m_password;
+    //! a flag to know if the pictures must be ignored
+    bool m_skipPictures;
+    /** a flag to know if the text of a word processing document must be sent as soon as it is read.
+
+     This reduces the memory used to convert big documents, but the page spans can be created with less
+     information, so the result may differ slightly from the normal conversion. */
+    bool m_progressive;
+    /** a flag to know if the independent parts of a document (the spreadsheet tables, some
+     text document's sub-streams) can be read in several threads. */
+    bool m_useThreads;
+    //! the maximal duration of the parsing in seconds, 0 means no limit
+    double m_maxDuration;
+    //! the maximal size in bytes of the bulk data (bitmaps, polygons, ...) created by the parsing, 0 means no limit
+    unsigned long m_maxAllocationSize;
+    /** a function called regularly during the parsing with m_cancelData: the parsing is stopped if it returns true.
+
+     \note this function can be called by different threads */
+    bool (*m_cancelCallback)(void *data);
+    //! the data sent to m_cancelCallback
+    void *m_cancelData;
+  };
+
+  /** a class used to retrieve the interface which receives each page, see parsePages */
+  class PageInterfaceFactory
+  {
+  public:
+    //! destructor
+    virtual ~PageInterfaceFactory() {}
+    /** returns the interface which must receive the page-th page (0<=page<numPages) or 0 to skip it.
+
+     \note this function is called in the calling thread before any page is sent */
+    virtual librevenge::RVNGDrawingInterface *getPageInterface(int page, int numPages) = 0;
+  };
+
+  /** a structure used to define the options of a direct CSV conversion, see parseToCSV */
+  struct CSVOptions {
+    //! constructor
+    CSVOptions()
+      : m_fieldSeparator(',')
+      , m_textSeparator('"')
+      , m_decimalSeparator('.')
+      , m_generateFormula(false)
+      , m_dateFormat("%m/%d/%y")
+      , m_timeFormat("%H:%M:%S")
+      , m_sheet(0)
+    {
+    }
+    //! the field separator
+    char m_fieldSeparator;
+    //! the text separator
+    char m_textSeparator;
+    //! the decimal separator
+    char m_decimalSeparator;
+    //! a flag to know if we output the formula which exist in the file or their values
+    bool m_generateFormula;
+    //! the date format (a strftime format)
+    char const *m_dateFormat;
+    //! the time format (a strftime format)
+    char const *m_timeFormat;
+    //! the sheet to convert: 0 means the first sheet, a negative value means no sheet
+    int m_sheet;
   };
 
   /** Analyzes the content of an input stream to see if it can be parsed
@@ -105,6 +190,12 @@ public:
 
    \note Reserved for future use. Actually, it only returns false */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password=0);
+  /** Parses the input stream content using some options. \see parse
+     \param input The input stream
+     \param documentInterface A RVNGTextInterface implementation
+     \param options The parsing options
+   */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGDrawingInterface class implementation when needed. This is often commonly called the
@@ -115,6 +206,12 @@ public:
 
      \note Reserved for future use. Actually, it only returns false. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password=0);
+  /** Parses the input stream content using some options. \see parse
+     \param input The input stream
+     \param documentInterface A RVNGDrawingInterface implementation
+     \param options The parsing options
+   */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGPresentationInterface class implementation when needed. This is often commonly called the
@@ -125,6 +222,12 @@ public:
 
      \note Reserved for future use. Actually, it only returns false. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password=0);
+  /** Parses the input stream content using some options. \see parse
+     \param input The input stream
+     \param documentInterface A RVNGPresentationInterface implementation
+     \param options The parsing options
+   */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, ParseOptions const &options);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGSpreadsheetInterface class implementation when needed. This is often commonly called the
@@ -135,6 +238,112 @@ public:
 
    \note Can only convert some basic documents: retrieving more cells' contents but no formating. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password=0);
+  /** Parses the input stream content using some options. \see parse
+     \param input The input stream
+     \param documentInterface A RVNGSpreadsheetInterface implementation
+     \param options The parsing options
+   */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, ParseOptions const &options);
+
+  /** Parses the input stream content of a spreadsheet and writes the CSV corresponding
+     to one of its sheets directly in a file descriptor. The rows are written as soon as
+     they are produced, ie. the sheet is never stored in memory.
+     \param input The input stream
+     \param fd The file descriptor where the CSV data are written
+     \param options The CSV options: separators, date/time formats, sheet to convert, ...
+     \param numSheets Filled with the number of sheets found in the document
+     \param password The file password
+
+   \note if no sheet corresponds to options.m_sheet, nothing is written. */
+  static STOFFLIB Result parseToCSV(librevenge::RVNGInputStream *input, int fd, CSVOptions const &options, int &numSheets, char const *password=0);
+  /** Parses the input stream content of a spreadsheet and writes the CSV corresponding to one of its sheets
+     using some parsing options. \see parseToCSV
+     \param input The input stream
+     \param fd The file descriptor where the CSV data are written
+     \param options The CSV options
+     \param numSheets Filled with the number of sheets found in the document
+     \param parseOptions The parsing options
+   */
+  static STOFFLIB Result parseToCSV(librevenge::RVNGInputStream *input, int fd, CSVOptions const &options, int &numSheets, ParseOptions const &parseOptions);
+
+  /** Extracts only the text content of a text, spreadsheet, drawing or presentation document
+     and sends it to a librevenge::RVNGTextInterface: the styles, the page spans and the pictures
+     are never retrieved, which makes this function much faster than parse when only the text is
+     needed (for instance, to index a document).
+     \param input The input stream
+     \param documentInterface A RVNGTextInterface implementation
+     \param password The file password
+
+   \note only paragraphs(with eventually an outline level), tabs and line breaks are created. */
+  static STOFFLIB Result extractText(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password=0);
+  /** Extracts only the text content of a document using some options. \see extractText
+     \param input The input stream
+     \param documentInterface A RVNGTextInterface implementation
+     \param options The parsing options
+   */
+  static STOFFLIB Result extractText(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options);
+
+  /** Reads only the document information stored in the input stream (title, subject,
+     keywords, authors, dates, user fields, ...) and appends them to metaData using the
+     librevenge meta-data names. The document content is never read, so the time spent in
+     this function does not depend on the document size.
+     \param input The input stream
+     \param metaData The property list which is filled with the meta data
+     \param options The parsing options
+
+   \note returns STOFF_R_PARSE_ERROR if the file does not contain any document information. */
+  static STOFFLIB Result parseMetaData(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &metaData, ParseOptions const &options=ParseOptions());
+
+  /** Parses only the preview stored in the input stream and sends it to a
+     librevenge::RVNGDrawingInterface as a one page drawing: the main document streams are
+     never read, which makes this function much faster than parse when only a thumbnail is
+     needed.
+     \param input The input stream
+     \param documentInterface A RVNGDrawingInterface implementation
+     \param password The file password
+
+   \note returns STOFF_R_PARSE_ERROR if the file does not contain any preview. */
+  static STOFFLIB Result parseThumbnail(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password=0);
+  /** Parses only the preview stored in the input stream using some options. \see parseThumbnail
+     \param input The input stream
+     \param documentInterface A RVNGDrawingInterface implementation
+     \param options The parsing options
+   */
+  static STOFFLIB Result parseThumbnail(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options);
+
+  /** Parses a drawing or a presentation document once and sends each of its pages to a
+     different librevenge::RVNGDrawingInterface as a one page drawing (with its master page).
+     The pages are sent simultaneously in different threads, so each interface must only
+     be used by its page, but the interfaces do not need to be thread safe.
+     \param input The input stream
+     \param factory The factory which returns the interface of each page
+     \param options The parsing options
+
+   \note returns STOFF_R_UNKNOWN_ERROR if the document is not a drawing or a presentation. */
+  static STOFFLIB Result parsePages(librevenge::RVNGInputStream *input, PageInterfaceFactory &factory, ParseOptions const &options=ParseOptions());
+
+  /** Reads only the index of a gallery theme (.sdg): the images are not decoded. For each image,
+     a property list is appended to index with "stoff:offset" (the image position in the input),
+     "stoff:type" (the image type) and "stoff:width", "stoff:height" (the bitmap size in pixels).
+     The images whose position does not fit in an int are ignored.
+     \param input The input stream
+     \param index The list of images
+     \param options The parsing options
+
+   \note returns STOFF_R_UNKNOWN_ERROR if the document is not a gallery theme. */
+  static STOFFLIB Result parseGalleryIndex(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyListVector &index, ParseOptions const &options=ParseOptions());
+  /** Decodes some images of a gallery theme (.sdg) and sends each of them to a different
+     librevenge::RVNGDrawingInterface as a one page drawing. The factory is called with the
+     position of each image in index and can return 0 to skip it, which allows to decode a
+     single image or a range of images. The images are decoded simultaneously in different threads.
+     \param input The input stream
+     \param index The list of images, created by parseGalleryIndex (or a part of it)
+     \param factory The factory which returns the interface of each image
+     \param options The parsing options
+
+   \note returns STOFF_R_PARSE_ERROR if an image can not be decoded. */
+  static STOFFLIB Result parseGalleryItems(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyListVector const &index,
+                                           PageInterfaceFactory &factory, ParseOptions const &options=ParseOptions());
 
   // ------------------------------------------------------------
   // decoders of the embedded zones created by libstoff
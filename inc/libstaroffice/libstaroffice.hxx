@@ -43,11 +43,13 @@
 /** Defines the spreadsheet processing possible conversion:
     - 1: can convert some basic document(from libstoff-0.0.0)
     - 2: can generate some spreadsheet OLE(from libstoff-0.0.2)
+    - 3: can write directly a sheet in CSV, see STOFFDocument::parseToCSV
  */
-#define STOFF_SPREADSHEET_VERSION 2
+#define STOFF_SPREADSHEET_VERSION 3
 /** Defines the word processing possible conversion:
-    - 1: can convert some sdw files(from libstoff-0.0.2) */
-#define STOFF_TEXT_VERSION 1
+    - 1: can convert some sdw files(from libstoff-0.0.2)
+    - 2: can extract only the text of a document, see STOFFDocument::extractText */
+#define STOFF_TEXT_VERSION 2
 
 #include "STOFFDocument.hxx"
 
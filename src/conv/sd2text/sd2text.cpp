@@ -62,6 +62,7 @@ static int printUsage()
   printf("\t-o OUTPUT         write ouput to OUTPUT\n");
   printf("\t-p PASSWORD       set password to open the file\n");
   printf("\t-v                show version information\n");
+  printf("\t-x                only extract the text: faster, but the tables, the frames, ... are not reconstructed\n");
   printf("\n");
   printf("Report bugs to <https://github.com/fosnola/libstaroffice/issues>.\n");
   return 0;
@@ -81,10 +82,11 @@ int main(int argc, char *argv[])
   char const *output = 0;
   char const *password=0;
   bool isInfo = false;
+  bool extractText = false;
   bool printHelp=false;
   int ch;
 
-  while ((ch = getopt(argc, argv, "hio:p:v")) != -1) {
+  while ((ch = getopt(argc, argv, "hio:p:vx")) != -1) {
     switch (ch) {
     case 'i':
       isInfo=true;
@@ -98,6 +100,9 @@ int main(int argc, char *argv[])
     case 'v':
       printVersion();
       return 0;
+    case 'x':
+      extractText=true;
+      break;
     default:
     case 'h':
       printHelp = true;
@@ -130,7 +135,11 @@ int main(int argc, char *argv[])
   bool useStringVector=false;
   auto error = STOFFDocument::STOFF_R_OK;
   try {
-    if (kind == STOFFDocument::STOFF_K_DRAW || kind == STOFFDocument::STOFF_K_GRAPHIC) {
+    if (extractText && kind != STOFFDocument::STOFF_K_GRAPHIC) {
+      librevenge::RVNGTextTextGenerator documentGenerator(document, isInfo);
+      error=STOFFDocument::extractText(&input, &documentGenerator, password);
+    }
+    else if (kind == STOFFDocument::STOFF_K_DRAW || kind == STOFFDocument::STOFF_K_GRAPHIC) {
       if (isInfo) {
         printf("ERROR: can not print info concerning a graphic document!\n");
         return 1;
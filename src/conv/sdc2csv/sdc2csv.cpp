@@ -31,17 +31,16 @@
 * instead of those above.
 */
 
+#include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 
 #include <cstdlib>
 #include <cstring>
-#include <fstream>
 #include <iostream>
 
 #include <librevenge/librevenge.h>
-#include <librevenge-generators/librevenge-generators.h>
 #include <librevenge-stream/librevenge-stream.h>
 
 #include <libstaroffice/libstaroffice.hxx>
@@ -164,14 +163,31 @@ int main(int argc, char *argv[])
     fprintf(stderr,"ERROR: not a spreadsheet!\n");
     return 1;
   }
-  auto error=STOFFDocument::STOFF_R_OK;
-  librevenge::RVNGStringVector vec;
+  STOFFDocument::CSVOptions options;
+  options.m_fieldSeparator=fieldSeparator;
+  options.m_textSeparator=textSeparator;
+  options.m_decimalSeparator=decSeparator;
+  options.m_generateFormula=generateFormula;
+  options.m_dateFormat=dateFormat.c_str();
+  options.m_timeFormat=timeFormat.c_str();
+  options.m_sheet=printNumberOfSheet ? -1 : sheetToConvert>0 ? sheetToConvert-1 : 0;
+
+  // the sheets are written in a temporary file which replaces the output when the conversion succeeds
+  int fd=1;
+  std::string tmpOutput;
+  if (output && !printNumberOfSheet) {
+    tmpOutput=std::string(output)+".tmp";
+    fd=open(tmpOutput.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0666);
+    if (fd<0) {
+      fprintf(stderr, "ERROR: can not open %s!\n", tmpOutput.c_str());
+      return 1;
+    }
+  }
 
+  auto error=STOFFDocument::STOFF_R_OK;
+  int numSheets=0;
   try {
-    librevenge::RVNGCSVSpreadsheetGenerator listenerImpl(vec, generateFormula);
-    listenerImpl.setSeparators(fieldSeparator, textSeparator, decSeparator);
-    listenerImpl.setDTFormats(dateFormat.c_str(),timeFormat.c_str());
-    error= STOFFDocument::parse(&input, &listenerImpl);
+    error= STOFFDocument::parseToCSV(&input, fd, options, numSheets);
   }
   catch (STOFFDocument::Result const &err) {
     error=err;
@@ -179,6 +195,22 @@ int main(int argc, char *argv[])
   catch (...) {
     error=STOFFDocument::STOFF_R_UNKNOWN_ERROR;
   }
+  if (fd!=1)
+    close(fd);
+  if (!tmpOutput.empty()) {
+    if (error == STOFFDocument::STOFF_R_OK && options.m_sheet<numSheets) {
+#ifdef _WIN32
+      remove(output);
+#endif
+      if (rename(tmpOutput.c_str(), output)!=0) {
+        fprintf(stderr, "ERROR: can not create %s!\n", output);
+        remove(tmpOutput.c_str());
+        return 1;
+      }
+    }
+    else
+      remove(tmpOutput.c_str());
+  }
   if (error == STOFFDocument::STOFF_R_FILE_ACCESS_ERROR)
     fprintf(stderr, "ERROR: File Exception!\n");
   else if (error == STOFFDocument::STOFF_R_PARSE_ERROR)
@@ -192,21 +224,14 @@ int main(int argc, char *argv[])
     return 1;
 
   if (printNumberOfSheet) {
-    std::cout << vec.size() << "\n";
+    std::cout << numSheets << "\n";
     return 0;
   }
 
-  unsigned page=sheetToConvert>0 ? unsigned(sheetToConvert-1) : 0;
-  if (page>=vec.size()) {
-    fprintf(stderr, "ERROR: can not find page %d!\n", int(page));
+  if (options.m_sheet>=numSheets) {
+    fprintf(stderr, "ERROR: can not find page %d!\n", options.m_sheet);
     return 1;
   }
-  if (!output)
-    std::cout << vec[page].cstr() << std::endl;
-  else {
-    std::ofstream out(output);
-    out << vec[page].cstr() << std::endl;
-  }
   return 0;
 }
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
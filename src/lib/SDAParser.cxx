@@ -31,16 +31,21 @@
 * instead of those above.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <thread>
 
 #include <librevenge/librevenge.h>
 
 #include "STOFFGraphicListener.hxx"
+#include "STOFFList.hxx"
 #include "STOFFOLEParser.hxx"
+#include "STOFFTextExtractor.hxx"
 
 #include "StarFileManager.hxx"
 #include "StarObjectDraw.hxx"
@@ -140,6 +145,90 @@ void SDAParser::parse(librevenge::RVNGPresentationInterface *docInterface)
   if (!ok) throw(libstoff::ParseException());
 }
 
+void SDAParser::extractText(librevenge::RVNGTextInterface *docInterface)
+{
+  if (!docInterface || !getInput().get() || !checkHeader(0L))  throw(libstoff::ParseException());
+  bool ok = true;
+  try {
+    checkHeader(0L);
+    ok = createZones() && m_state->m_mainGraphic;
+    if (ok) {
+      STOFFTextExtractor extractor(docInterface);
+      extractor.startDocument(m_state->m_mainGraphic->getMetaData());
+      m_state->m_mainGraphic->extractText(extractor);
+      extractor.endDocument();
+    }
+    ascii().reset();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("SDAParser::extractText: exception catched when parsing\n"));
+    ok = false;
+  }
+  if (!ok) throw(libstoff::ParseException());
+}
+
+void SDAParser::parsePages(STOFFDocument::PageInterfaceFactory &factory)
+{
+  if (!getInput().get() || !checkHeader(0L))  throw(libstoff::ParseException());
+  bool ok = true;
+  try {
+    checkHeader(0L);
+    std::vector<STOFFPageSpan> pageList;
+    ok = createZones() && m_state->m_mainGraphic &&
+         m_state->m_mainGraphic->updatePageSpans(pageList, m_state->m_numPages) &&
+         m_state->m_numPages==int(pageList.size());
+    if (ok) {
+      // ask the interfaces in the main thread, so the factory does not need to be thread safe
+      size_t numPages=pageList.size();
+      std::vector<librevenge::RVNGDrawingInterface *> interfaces(numPages, nullptr);
+      for (size_t p=0; p<numPages; ++p)
+        interfaces[p]=factory.getPageInterface(int(p), int(numPages));
+
+      // the document's data are only read now, so each page can be created by a different thread
+      // with its own listener; the shared caches and inputs are protected by their own mutex
+      bool skipPictures=getParserState()->m_skipPictures;
+      auto const &mainGraphic=m_state->m_mainGraphic;
+      std::atomic<size_t> nextPage(0);
+      std::atomic<bool> allSent(true);
+      auto *guard=libstoff::ParseGuard::getCurrent();
+      auto sendPages=[&pageList, &interfaces, &nextPage, &allSent, &mainGraphic, skipPictures, numPages, guard]() {
+        libstoff::ParseGuard::setCurrent(guard);
+        for (size_t p=nextPage++; p<numPages; p=nextPage++) {
+          if (!interfaces[p]) continue;
+          try {
+            std::vector<STOFFPageSpan> pageSpan(1, pageList[p]);
+            pageSpan[0].m_pageSpan=1;
+            STOFFGraphicListenerPtr listen(new STOFFGraphicListener(STOFFListManagerPtr(new STOFFListManager), pageSpan, interfaces[p]));
+            listen->setSkipPictures(skipPictures);
+            listen->setDocumentMetaData(mainGraphic->getMetaData());
+            listen->startDocument();
+            mainGraphic->sendPageWithMaster(int(p), listen);
+            listen->endDocument();
+          }
+          catch (...) {
+            STOFF_DEBUG_MSG(("SDAParser::parsePages: find an exception when sending page %d\n", int(p)));
+            allSent=false;
+          }
+        }
+      };
+      size_t numThreads=std::min<size_t>(size_t(std::thread::hardware_concurrency()), numPages);
+      std::vector<std::thread> threads;
+      for (size_t i=1; i<numThreads; ++i)
+        threads.push_back(std::thread(sendPages));
+      sendPages();
+      for (auto &thread : threads)
+        thread.join();
+      ok=allSent;
+    }
+    ascii().reset();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("SDAParser::parsePages: exception catched when parsing\n"));
+    ok = false;
+  }
+  if (!ok) throw(libstoff::ParseException());
+}
+
 bool SDAParser::createZones()
 {
   m_oleParser.reset(new STOFFOLEParser);
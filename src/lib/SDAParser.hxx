@@ -80,6 +80,12 @@ public:
   void parse(librevenge::RVNGDrawingInterface *documentInterface) final;
   // the main presentation parse function
   void parse(librevenge::RVNGPresentationInterface *documentInterface) final;
+  /** sends only the text content of the document to a text interface: no style,
+      no page span, no picture. \see STOFFDocument::extractText */
+  void extractText(librevenge::RVNGTextInterface *documentInterface);
+  /** sends each page of the document to its own drawing interface, the pages being sent
+      simultaneously in different threads. \see STOFFDocument::parsePages */
+  void parsePages(STOFFDocument::PageInterfaceFactory &factory);
 
 protected:
   //! creates the listener which will be associated to the document
@@ -41,6 +41,7 @@
 
 #include "STOFFOLEParser.hxx"
 #include "STOFFSpreadsheetListener.hxx"
+#include "STOFFTextExtractor.hxx"
 
 #include "StarFileManager.hxx"
 #include "StarObjectSpreadsheet.hxx"
@@ -113,6 +114,28 @@ void SDCParser::parse(librevenge::RVNGSpreadsheetInterface *docInterface)
 }
 
 
+void SDCParser::extractText(librevenge::RVNGTextInterface *docInterface)
+{
+  if (!docInterface || !getInput().get() || !checkHeader(0L))  throw(libstoff::ParseException());
+  bool ok = true;
+  try {
+    checkHeader(0L);
+    ok = createZones() && m_state->m_mainSpreadsheet;
+    if (ok) {
+      STOFFTextExtractor extractor(docInterface);
+      extractor.startDocument(m_state->m_mainSpreadsheet->getMetaData());
+      m_state->m_mainSpreadsheet->extractText(extractor);
+      extractor.endDocument();
+    }
+    ascii().reset();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("SDCParser::extractText: exception catched when parsing\n"));
+    ok = false;
+  }
+  if (!ok) throw(libstoff::ParseException());
+}
+
 bool SDCParser::createZones()
 {
   m_oleParser.reset(new STOFFOLEParser);
@@ -125,6 +148,7 @@ bool SDCParser::createZones()
   }
   mainOle->m_parsed=true;
   StarObject mainObject(m_password, m_oleParser, mainOle);
+  mainObject.setUseThreads(getParserState()->m_useThreads);
   if (mainObject.getDocumentKind()!=STOFFDocument::STOFF_K_SPREADSHEET) {
     STOFF_DEBUG_MSG(("SDCParser::createZones: can not find the main spreadsheet\n"));
     return false;
@@ -78,6 +78,9 @@ public:
 
   // the main parse function
   void parse(librevenge::RVNGSpreadsheetInterface *documentInterface);
+  /** sends only the text content of the document to a text interface: no style,
+      no page span, no picture. \see STOFFDocument::extractText */
+  void extractText(librevenge::RVNGTextInterface *documentInterface);
 
 protected:
   //! creates the listener which will be associated to the document
@@ -31,16 +31,21 @@
 * instead of those above.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <thread>
 
 #include <librevenge/librevenge.h>
 
 #include "STOFFGraphicListener.hxx"
+#include "STOFFList.hxx"
 #include "STOFFOLEParser.hxx"
+#include "STOFFStringStream.hxx"
 #include "STOFFSubDocument.hxx"
 
 #include "StarBitmap.hxx"
@@ -72,17 +77,38 @@ public:
   librevenge::RVNGString m_link;
 };
 
+////////////////////////////////////////
+//! Internal: small structure use to store the position of an image in a SDGParser
+struct ImageIndex {
+  //! constructor
+  ImageIndex()
+    : m_offset(0)
+    , m_type(0)
+    , m_size()
+  {
+  }
+  //! the offset of the SGA3 header
+  long m_offset;
+  //! the image type
+  int m_type;
+  //! the bitmap size
+  STOFFVec2i m_size;
+};
+
 ////////////////////////////////////////
 //! Internal: the state of a SDGParser
 struct State {
   //! constructor
   State()
     : m_imagesList()
+    , m_indexList()
   {
   }
 
   //! the list of image
   std::vector<Image> m_imagesList;
+  //! the list of image positions (only filled by parseIndex)
+  std::vector<ImageIndex> m_indexList;
 };
 
 ////////////////////////////////////////
@@ -156,11 +182,6 @@ void SDGParser::parse(librevenge::RVNGDrawingInterface *docInterface)
       createDocument(docInterface);
       STOFFListenerPtr listener=getGraphicListener();
       if (listener) {
-        STOFFPosition position;
-        position.setAnchor(STOFFPosition::Page);
-        STOFFGraphicStyle style;
-        style.m_propertyList.insert("draw:stroke", "none");
-        style.m_propertyList.insert("draw:fill", "none");
         bool first=true;
         for (auto const &image : m_state->m_imagesList) {
           if (image.m_object.isEmpty())
@@ -169,16 +190,7 @@ void SDGParser::parse(librevenge::RVNGDrawingInterface *docInterface)
             listener->insertBreak(STOFFListener::PageBreak);
           else
             first=false;
-          position.setOrigin(STOFFVec2f(20,20), librevenge::RVNG_POINT);
-          STOFFVec2f size=(image.m_size[0]>0 && image.m_size[1]>0) ? STOFFVec2f(image.m_size) : STOFFVec2f(400,400);
-          position.setSize(size, librevenge::RVNG_POINT);
-          listener->insertPicture(position, image.m_object, style);
-          if (!image.m_link.empty()) {
-            std::shared_ptr<SDGParserInternal::SubDocument> doc(new SDGParserInternal::SubDocument(image.m_link));
-            position.setOrigin(STOFFVec2f(20,30+size[1]), librevenge::RVNG_POINT);
-            position.setSize(STOFFVec2f(600,200), librevenge::RVNG_POINT);
-            listener->insertTextBox(position, doc, style);
-          }
+          sendImage(listener, image);
         }
       }
     }
@@ -193,6 +205,133 @@ void SDGParser::parse(librevenge::RVNGDrawingInterface *docInterface)
   if (!ok) throw(libstoff::ParseException());
 }
 
+void SDGParser::parseIndex(librevenge::RVNGPropertyListVector &index)
+{
+  if (!getInput().get() || !checkHeader(0L))  throw(libstoff::ParseException());
+  bool ok = true;
+  try {
+    checkHeader(0L);
+    ok = createIndex();
+    for (auto const &entry : m_state->m_indexList) {
+      if (entry.m_offset>long(std::numeric_limits<int>::max())) {
+        // the offset is stored as an int
+        STOFF_DEBUG_MSG(("SDGParser::parseIndex: the offset %ld is too big, ignore the image\n", entry.m_offset));
+        continue;
+      }
+      librevenge::RVNGPropertyList item;
+      item.insert("stoff:offset", int(entry.m_offset));
+      item.insert("stoff:type", entry.m_type);
+      item.insert("stoff:width", entry.m_size[0]);
+      item.insert("stoff:height", entry.m_size[1]);
+      index.append(item);
+    }
+    ascii().reset();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("SDGParser::parseIndex: exception catched when parsing\n"));
+    ok = false;
+  }
+  if (!ok) throw(libstoff::ParseException());
+}
+
+void SDGParser::parseItems(librevenge::RVNGPropertyListVector const &index, STOFFDocument::PageInterfaceFactory &factory)
+{
+  STOFFInputStreamPtr input=getInput();
+  if (!input.get() || !checkHeader(0L))  throw(libstoff::ParseException());
+  size_t numItems=size_t(index.count());
+  std::vector<long> offsets(numItems, 0);
+  std::vector<librevenge::RVNGDrawingInterface *> interfaces(numItems, nullptr);
+  size_t numRequested=0;
+  for (size_t i=0; i<numItems; ++i) {
+    interfaces[i]=factory.getPageInterface(int(i), int(numItems));
+    if (!interfaces[i]) continue;
+    ++numRequested;
+    if (index[unsigned(i)]["stoff:offset"])
+      offsets[i]=long(index[unsigned(i)]["stoff:offset"]->getInt());
+  }
+  if (!numRequested) return;
+  size_t numThreads=std::min<size_t>(size_t(std::thread::hardware_concurrency()), numRequested);
+  /* each thread needs its own stream, so copy the input data in a buffer which will be shared by the streams,
+     a single image is decoded with the parser input */
+  std::shared_ptr<std::vector<unsigned char> > buffer;
+  if (numThreads>1 && input->size()>0) {
+    input->seek(0, librevenge::RVNG_SEEK_SET);
+    unsigned long numRead;
+    auto const *data=input->read(size_t(input->size()), numRead);
+    if (data && long(numRead)==input->size())
+      buffer=std::make_shared<std::vector<unsigned char> >(data, data+numRead);
+  }
+  if (!buffer) numThreads=1;
+
+  std::atomic<size_t> nextItem(0);
+  std::atomic<bool> allSent(true);
+  auto *guard=libstoff::ParseGuard::getCurrent();
+  auto sendItems=[this, &buffer, &offsets, &interfaces, &nextItem, &allSent, numItems, input, guard]() {
+    libstoff::ParseGuard::setCurrent(guard);
+    STOFFInputStreamPtr tInput=input;
+    if (buffer) {
+      std::shared_ptr<librevenge::RVNGInputStream> stream(new STOFFStringStream(buffer));
+      tInput.reset(new STOFFInputStream(stream, input->readInverted()));
+    }
+    StarZone zone(tInput, "", "SDGDocument", m_password);
+    for (size_t i=nextItem++; i<numItems; i=nextItem++) {
+      if (!interfaces[i]) continue;
+      try {
+        SDGParserInternal::Image image;
+        if (offsets[i]<0 || !tInput->checkPosition(offsets[i]+4)) {
+          STOFF_DEBUG_MSG(("SDGParser::parseItems: the offset of item %d is bad\n", int(i)));
+          allSent=false;
+          continue;
+        }
+        tInput->seek(offsets[i], librevenge::RVNG_SEEK_SET);
+        if (tInput->readULong(4)!=0x33414753 || !readBitmap(zone, image) || image.m_object.isEmpty()) {
+          STOFF_DEBUG_MSG(("SDGParser::parseItems: can not read item %d\n", int(i)));
+          allSent=false;
+          continue;
+        }
+        std::vector<STOFFPageSpan> pageList(1, getPageSpan());
+        pageList[0].m_pageSpan=1;
+        STOFFGraphicListenerPtr listen(new STOFFGraphicListener(STOFFListManagerPtr(new STOFFListManager), pageList, interfaces[i]));
+        listen->startDocument();
+        sendImage(listen, image);
+        listen->endDocument();
+      }
+      catch (...) {
+        STOFF_DEBUG_MSG(("SDGParser::parseItems: find an exception when reading item %d\n", int(i)));
+        allSent=false;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i=1; i<numThreads; ++i)
+    threads.push_back(std::thread(sendItems));
+  sendItems();
+  for (auto &thread : threads)
+    thread.join();
+  if (!allSent) throw(libstoff::ParseException());
+}
+
+bool SDGParser::createIndex()
+{
+  STOFFInputStreamPtr input=getInput();
+  if (!input)
+    return false;
+  StarZone zone(input, "", "SDGDocument", m_password);
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  while (!input->isEnd() && findSGA3Header(input)) {
+    SDGParserInternal::ImageIndex entry;
+    entry.m_offset=input->tell()-4;
+    long endPos=0;
+    if (readImageIndex(zone, entry, endPos))
+      m_state->m_indexList.push_back(entry);
+    else
+      input->seek(entry.m_offset+4, librevenge::RVNG_SEEK_SET);
+    // if the end of the bitmap is unknown, look for the next header after the bitmap's headers
+    if (endPos>input->tell())
+      input->seek(endPos, librevenge::RVNG_SEEK_SET);
+  }
+  return !m_state->m_indexList.empty();
+}
 
 bool SDGParser::createZones()
 {
@@ -235,6 +374,26 @@ void SDGParser::createDocument(librevenge::RVNGDrawingInterface *documentInterfa
   listen->startDocument();
 }
 
+void SDGParser::sendImage(STOFFListenerPtr listener, SDGParserInternal::Image const &image)
+{
+  if (!listener) return;
+  STOFFPosition position;
+  position.setAnchor(STOFFPosition::Page);
+  STOFFGraphicStyle style;
+  style.m_propertyList.insert("draw:stroke", "none");
+  style.m_propertyList.insert("draw:fill", "none");
+  position.setOrigin(STOFFVec2f(20,20), librevenge::RVNG_POINT);
+  STOFFVec2f size=(image.m_size[0]>0 && image.m_size[1]>0) ? STOFFVec2f(image.m_size) : STOFFVec2f(400,400);
+  position.setSize(size, librevenge::RVNG_POINT);
+  listener->insertPicture(position, image.m_object, style);
+  if (!image.m_link.empty()) {
+    std::shared_ptr<SDGParserInternal::SubDocument> doc(new SDGParserInternal::SubDocument(image.m_link));
+    position.setOrigin(STOFFVec2f(20,30+size[1]), librevenge::RVNG_POINT);
+    position.setSize(STOFFVec2f(600,200), librevenge::RVNG_POINT);
+    listener->insertTextBox(position, doc, style);
+  }
+}
+
 ////////////////////////////////////////////////////////////
 //
 // Intermediate level
@@ -246,25 +405,7 @@ bool SDGParser::readSGA3(StarZone &zone)
   if (!input || input->isEnd())
     return false;
   long pos=input->tell();
-  // look for 53474133
-  bool findHeader=false;
-  while (true) {
-    if (!input->checkPosition(input->tell()+10)) {
-      findHeader=false;
-      break;
-    }
-    long val=int(input->readULong(4));
-    if (val==0x33414753) {
-      findHeader=true;
-      break;
-    }
-    if ((val>>8)==0x414753)
-      input->seek(-3, librevenge::RVNG_SEEK_CUR);
-    else if ((val>>16)==0x4753)
-      input->seek(-2, librevenge::RVNG_SEEK_CUR);
-    else if ((val>>24)==0x47)
-      input->seek(-1, librevenge::RVNG_SEEK_CUR);
-  }
+  bool findHeader=findSGA3Header(input);
   libstoff::DebugFile &ascFile=zone.ascii();
   libstoff::DebugStream f;
   f << "Entries(SGA3):";
@@ -280,12 +421,52 @@ bool SDGParser::readSGA3(StarZone &zone)
   }
   ascFile.addPos(pos);
   ascFile.addNote(f.str().c_str());
-  if (findHeader)
-    readBitmap(zone);
+  if (findHeader) {
+    SDGParserInternal::Image image;
+    if (readBitmap(zone, image) && !image.m_object.isEmpty())
+      m_state->m_imagesList.push_back(image);
+  }
   return findHeader;
 }
 
-bool SDGParser::readBitmap(StarZone &zone)
+bool SDGParser::findSGA3Header(STOFFInputStreamPtr input)
+{
+  // look for 53474133
+  while (true) {
+    libstoff::ParseGuard::check();
+    if (!input->checkPosition(input->tell()+10))
+      return false;
+    long val=int(input->readULong(4));
+    if (val==0x33414753)
+      return true;
+    if ((val>>8)==0x414753)
+      input->seek(-3, librevenge::RVNG_SEEK_CUR);
+    else if ((val>>16)==0x4753)
+      input->seek(-2, librevenge::RVNG_SEEK_CUR);
+    else if ((val>>24)==0x47)
+      input->seek(-1, librevenge::RVNG_SEEK_CUR);
+  }
+}
+
+bool SDGParser::readImageIndex(StarZone &zone, SDGParserInternal::ImageIndex &entry, long &endPos)
+{
+  endPos=0;
+  STOFFInputStreamPtr input=zone.input();
+  if (!input->checkPosition(input->tell()+9)) return false;
+  // see readBitmap
+  input->seek(6, librevenge::RVNG_SEEK_CUR);
+  entry.m_type=int(input->readULong(1));
+  if (entry.m_type<1 || entry.m_type>2 || input->readULong(2)!=0x4D42)
+    return false;
+  input->seek(-2, librevenge::RVNG_SEEK_CUR);
+  StarBitmap bitmap;
+  if (!bitmap.readBitmapHeaders(zone, input->size(), endPos))
+    return false;
+  entry.m_size=bitmap.getBitmapSize();
+  return true;
+}
+
+bool SDGParser::readBitmap(StarZone &zone, SDGParserInternal::Image &image) const
 {
   STOFFInputStreamPtr input=zone.input();
   if (!input)
@@ -300,7 +481,6 @@ bool SDGParser::readBitmap(StarZone &zone)
     int const expected[]= {4,5,1};
     if (val!=expected[i]) f << "f" << i << "=" << val << ",";
   }
-  SDGParserInternal::Image image;
   int val;
   for (int step=0; step<2; ++step) {
     int type=int(input->readULong(1));
@@ -382,8 +562,6 @@ bool SDGParser::readBitmap(StarZone &zone)
     f << "SGA3:";
     if (findText) break;
   }
-  if (!image.m_object.isEmpty())
-    m_state->m_imagesList.push_back(image);
   if (input->checkPosition(input->tell()+2)) {
     long actPos=input->tell();
     val=int(input->readULong(2));
@@ -48,6 +48,8 @@
 
 namespace SDGParserInternal
 {
+class Image;
+struct ImageIndex;
 struct State;
 }
 
@@ -78,13 +80,23 @@ public:
 
   // the main parse function
   void parse(librevenge::RVNGDrawingInterface *documentInterface);
+  /** reads only the position, the type and the size of each image, without decoding them.
+      \see STOFFDocument::parseGalleryIndex */
+  void parseIndex(librevenge::RVNGPropertyListVector &index);
+  /** decodes the images of an index and sends each of them to its own drawing interface,
+      the images being decoded simultaneously in different threads. \see STOFFDocument::parseGalleryItems */
+  void parseItems(librevenge::RVNGPropertyListVector const &index, STOFFDocument::PageInterfaceFactory &factory);
 
 protected:
   //! creates the listener which will be associated to the document
   void createDocument(librevenge::RVNGDrawingInterface *documentInterface);
+  //! sends an image and its link to the listener
+  static void sendImage(STOFFListenerPtr listener, SDGParserInternal::Image const &image);
 
   //! parses the different OLE, ...
   bool createZones();
+  //! creates the image index
+  bool createIndex();
 
   //
   // low level
@@ -92,8 +104,12 @@ protected:
 
   //! try to read a SGA3 zone
   bool readSGA3(StarZone &zone);
+  //! try to find the next SGA3 header, if found the position is set after the header
+  static bool findSGA3Header(STOFFInputStreamPtr input);
   //! try to read a bitmap
-  bool readBitmap(StarZone &zone);
+  bool readBitmap(StarZone &zone, SDGParserInternal::Image &image) const;
+  //! try to read the index of a SGA3 zone: its type and bitmap size, sets endPos to the bitmap end if it is known
+  static bool readImageIndex(StarZone &zone, SDGParserInternal::ImageIndex &entry, long &endPos);
 
   //
   // data
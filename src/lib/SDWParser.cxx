@@ -41,6 +41,7 @@
 
 #include "STOFFOLEParser.hxx"
 #include "STOFFTextListener.hxx"
+#include "STOFFTextExtractor.hxx"
 
 #include "StarFileManager.hxx"
 #include "StarObjectText.hxx"
@@ -94,11 +95,13 @@ void SDWParser::parse(librevenge::RVNGTextInterface *docInterface)
   try {
     // create the asciiFile
     checkHeader(0L);
-    ok = createZones();
+    ok = createZones(getParserState()->m_sendProgressively ? docInterface : nullptr);
     if (ok) {
-      createDocument(docInterface);
-      if (m_state->m_mainText)
-        m_state->m_mainText->sendPages(getTextListener());
+      if (!getTextListener()) { // the main text is not already sent
+        createDocument(docInterface);
+        if (m_state->m_mainText)
+          m_state->m_mainText->sendPages(getTextListener());
+      }
 #ifdef DEBUG
       StarFileManager::checkUnparsed(getInput(), m_oleParser, m_password);
 #endif
@@ -115,7 +118,29 @@ void SDWParser::parse(librevenge::RVNGTextInterface *docInterface)
 }
 
 
-bool SDWParser::createZones()
+void SDWParser::extractText(librevenge::RVNGTextInterface *docInterface)
+{
+  if (!docInterface || !getInput().get() || !checkHeader(0L))  throw(libstoff::ParseException());
+  bool ok = true;
+  try {
+    checkHeader(0L);
+    ok = createZones() && m_state->m_mainText;
+    if (ok) {
+      STOFFTextExtractor extractor(docInterface);
+      extractor.startDocument(m_state->m_mainText->getMetaData());
+      m_state->m_mainText->extractText(extractor);
+      extractor.endDocument();
+    }
+    ascii().reset();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("SDWParser::extractText: exception catched when parsing\n"));
+    ok = false;
+  }
+  if (!ok) throw(libstoff::ParseException());
+}
+
+bool SDWParser::createZones(librevenge::RVNGTextInterface *documentInterface)
 {
   m_oleParser.reset(new STOFFOLEParser);
   m_oleParser->parse(getInput());
@@ -126,12 +151,21 @@ bool SDWParser::createZones()
   }
   mainOle->m_parsed=true;
   StarObject mainObject(m_password, m_oleParser, mainOle);
+  mainObject.setUseThreads(getParserState()->m_useThreads);
   if (mainObject.getDocumentKind()!=STOFFDocument::STOFF_K_TEXT) {
     STOFF_DEBUG_MSG(("SDWParser::createZones: can not find the main graphic\n"));
     return false;
   }
   m_state->m_mainText.reset(new StarObjectText(mainObject, false));
-  return m_state->m_mainText->parse();
+  if (!documentInterface)
+    return m_state->m_mainText->parse();
+  auto creator=[this, documentInterface](std::vector<STOFFPageSpan> const &pageList) {
+    m_state->m_numPages=0;
+    for (auto const &page : pageList)
+      m_state->m_numPages+=page.m_pageSpan;
+    return createListener(pageList, documentInterface);
+  };
+  return m_state->m_mainText->parseAndSend(creator);
 }
 
 ////////////////////////////////////////////////////////////
@@ -147,12 +181,18 @@ void SDWParser::createDocument(librevenge::RVNGTextInterface *documentInterface)
     pageList.push_back(ps);
     m_state->m_numPages = 1;
   }
+  createListener(pageList, documentInterface);
+}
+
+STOFFTextListenerPtr SDWParser::createListener(std::vector<STOFFPageSpan> const &pageList, librevenge::RVNGTextInterface *documentInterface)
+{
   STOFFTextListenerPtr listen(new STOFFTextListener(getParserState()->m_listManager, pageList, documentInterface));
   setTextListener(listen);
   if (m_state->m_mainText)
     listen->setDocumentMetaData(m_state->m_mainText->getMetaData());
 
   listen->startDocument();
+  return listen;
 }
 
 
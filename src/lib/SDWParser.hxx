@@ -78,13 +78,20 @@ public:
 
   // the main parse function
   void parse(librevenge::RVNGTextInterface *documentInterface);
+  /** sends only the text content of the document to a text interface: no style,
+      no page span, no picture. \see STOFFDocument::extractText */
+  void extractText(librevenge::RVNGTextInterface *documentInterface);
 
 protected:
   //! creates the listener which will be associated to the document
   void createDocument(librevenge::RVNGTextInterface *documentInterface);
+  //! creates and starts the listener for a given list of page spans
+  STOFFTextListenerPtr createListener(std::vector<STOFFPageSpan> const &pageList, librevenge::RVNGTextInterface *documentInterface);
 
-  //! parses the different OLE, ...
-  bool createZones();
+  /** parses the different OLE, ...
+
+      If documentInterface is set, the main text is sent to this interface while it is read (if possible) */
+  bool createZones(librevenge::RVNGTextInterface *documentInterface=nullptr);
 
   //
   // low level
@@ -0,0 +1,785 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libstaroffice
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2002 William Lachance (wrlach@gmail.com)
+* Copyright (C) 2002,2004 Marc Maurer (uwog@uwog.net)
+* Copyright (C) 2004-2006 Fridrich Strba (fridrich.strba@bluewin.ch)
+* Copyright (C) 2006, 2007 Andrew Ziem
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+#include <errno.h>
+#if defined(_WIN32) || defined(_WIN64)
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include <librevenge/librevenge.h>
+#include <libstaroffice/libstaroffice.hxx>
+
+#include "libstaroffice_internal.hxx"
+
+#include "STOFFCSVSpreadsheetGenerator.hxx"
+
+//! a name space used to define internal data of STOFFCSVSpreadsheetGenerator
+namespace STOFFCSVSpreadsheetGeneratorInternal
+{
+//! the maximum size of the buffer before writing it in the file
+static size_t const s_bufferSize=64*1024;
+
+//! the state of a STOFFCSVSpreadsheetGenerator
+struct State {
+  //! constructor
+  State(int fd, STOFFDocument::CSVOptions const &options)
+    : m_fd(fd)
+    , m_fieldSeparator(options.m_fieldSeparator)
+    , m_textSeparator(options.m_textSeparator)
+    , m_decimalSeparator(options.m_decimalSeparator)
+    , m_generateFormula(options.m_generateFormula)
+    , m_dateFormat(options.m_dateFormat ? options.m_dateFormat : "%m/%d/%y")
+    , m_timeFormat(options.m_timeFormat ? options.m_timeFormat : "%H:%M:%S")
+    , m_sheetToConvert(options.m_sheet)
+    , m_buffer()
+    , m_isOk(true)
+    , m_numSheets(0)
+    , m_isSheetSelected(false)
+    , m_row()
+    , m_numRowsRepeated(1)
+    , m_numEmptyRows(0)
+    , m_numEmptyCells(0)
+    , m_isCellOpened(false)
+    , m_cell()
+    , m_cellHasValue(false)
+    , m_numCellsRepeated(1)
+    , m_numParagraphs(0)
+    , m_subLevel(0)
+  {
+  }
+  //! returns true if the text must be added in the current cell
+  bool canWriteText() const
+  {
+    return m_isSheetSelected && m_isCellOpened && !m_cellHasValue && m_subLevel==0;
+  }
+  //! writes the buffer content in the file
+  bool flush();
+  //! appends a double using the decimal separator
+  void appendDouble(std::string &str, double val) const;
+  //! appends a date/time using a strftime format
+  static void appendDateTime(std::string &str, std::string const &format, std::tm const &time);
+  //! appends the formula
+  void appendFormula(std::string &str, librevenge::RVNGPropertyListVector const &formula) const;
+  //! appends a cell content, adds some text separators if needed
+  void appendField(std::string &str, std::string const &field) const;
+
+  //! the file descriptor
+  int m_fd;
+  //! the field separator
+  char m_fieldSeparator;
+  //! the text separator
+  char m_textSeparator;
+  //! the decimal separator
+  char m_decimalSeparator;
+  //! flag to know if we output the formula
+  bool m_generateFormula;
+  //! the date format
+  std::string m_dateFormat;
+  //! the time format
+  std::string m_timeFormat;
+  //! the sheet to convert
+  int m_sheetToConvert;
+
+  //! the data which are not written
+  std::string m_buffer;
+  //! false if a write failed
+  bool m_isOk;
+  //! the number of sheets
+  int m_numSheets;
+  //! true if the actual sheet must be converted
+  bool m_isSheetSelected;
+
+  //! the actual row
+  std::string m_row;
+  //! the number of times the actual row is repeated
+  int m_numRowsRepeated;
+  //! the number of empty rows which are not written
+  int m_numEmptyRows;
+  //! the number of empty cells which are not written in the actual row
+  int m_numEmptyCells;
+
+  //! true if a cell is opened
+  bool m_isCellOpened;
+  //! the actual cell content
+  std::string m_cell;
+  //! true if the cell content is already defined: value, formula
+  bool m_cellHasValue;
+  //! the number of times the actual cell is repeated
+  int m_numCellsRepeated;
+  //! the number of paragraphs in the actual cell
+  int m_numParagraphs;
+  //! the number of opened frames, comments, ...
+  int m_subLevel;
+};
+
+bool State::flush()
+{
+  if (m_buffer.empty()) return m_isOk;
+  char const *data=m_buffer.c_str();
+  size_t remaining=m_buffer.size();
+  while (m_isOk && remaining) {
+#if defined(_WIN32) || defined(_WIN64)
+    int written=int(_write(m_fd, data, static_cast<unsigned>(remaining)));
+#else
+    long written=long(write(m_fd, data, remaining));
+#endif
+    if (written<0) {
+      if (errno==EINTR) continue;
+      STOFF_DEBUG_MSG(("STOFFCSVSpreadsheetGeneratorInternal::State::flush: can not write the data\n"));
+      m_isOk=false;
+      break;
+    }
+    data+=size_t(written);
+    remaining-=size_t(written);
+  }
+  m_buffer.clear();
+  return m_isOk;
+}
+
+void State::appendDouble(std::string &str, double val) const
+{
+  if (std::isnan(val)) {
+    str+="NaN";
+    return;
+  }
+  if (std::isinf(val)) {
+    str+=val<0 ? "-Inf" : "Inf";
+    return;
+  }
+  // first check for integer, the main case
+  if (val>-1e15 && val<1e15) {
+    auto iVal=static_cast<long long>(val);
+    if (double(iVal)>=val && double(iVal)<=val) {
+      char digits[24];
+      int n=0;
+      bool negative=iVal<0;
+      unsigned long long uVal=negative ? static_cast<unsigned long long>(-iVal) : static_cast<unsigned long long>(iVal);
+      do {
+        digits[n++]=char('0'+int(uVal%10));
+        uVal/=10;
+      }
+      while (uVal);
+      if (negative) str+='-';
+      while (n) str+=digits[--n];
+      return;
+    }
+  }
+  char buffer[40];
+  std::snprintf(buffer, sizeof(buffer), "%.15g", val);
+  // the locale decimal point can be anything, so replace all the unexpected characters
+  for (char const *c=buffer; *c; ++c) {
+    if ((*c>='0' && *c<='9') || *c=='-' || *c=='+' || *c=='e' || *c=='E')
+      str+=*c;
+    else
+      str+=m_decimalSeparator;
+  }
+}
+
+void State::appendDateTime(std::string &str, std::string const &format, std::tm const &time)
+{
+  char buffer[256];
+  size_t len=std::strftime(buffer, sizeof(buffer), format.c_str(), &time);
+  if (len>0 && len<sizeof(buffer))
+    str.append(buffer, len);
+}
+
+//! appends a column/row cell's reference
+static void appendCellReference(std::string &str, int col, bool colAbsolute, int row, bool rowAbsolute)
+{
+  if (colAbsolute) str+='$';
+  if (col<0)
+    str+="C"+std::to_string(col);
+  else {
+    char letters[8];
+    int n=0;
+    ++col;
+    while (col>0 && n<8) {
+      letters[n++]=char('A'+(col-1)%26);
+      col=(col-1)/26;
+    }
+    while (n) str+=letters[--n];
+  }
+  if (rowAbsolute) str+='$';
+  str+=std::to_string(row+1);
+}
+
+void State::appendFormula(std::string &str, librevenge::RVNGPropertyListVector const &formula) const
+{
+  str+='=';
+  for (unsigned long i=0; i<formula.count(); ++i) {
+    auto const &instr=formula[i];
+    if (!instr["librevenge:type"]) continue;
+    librevenge::RVNGString type=instr["librevenge:type"]->getStr();
+    if (type=="librevenge-operator" && instr["librevenge:operator"])
+      str+=instr["librevenge:operator"]->getStr().cstr();
+    else if (type=="librevenge-function" && instr["librevenge:function"])
+      str+=instr["librevenge:function"]->getStr().cstr();
+    else if (type=="librevenge-number" && instr["librevenge:number"])
+      appendDouble(str, instr["librevenge:number"]->getDouble());
+    else if (type=="librevenge-text" && instr["librevenge:text"]) {
+      str+='"';
+      for (char const *c=instr["librevenge:text"]->getStr().cstr(); *c; ++c) {
+        if (*c=='"') str+='"';
+        str+=*c;
+      }
+      str+='"';
+    }
+    else if (type=="librevenge-cell" && instr["librevenge:column"] && instr["librevenge:row"]) {
+      if (instr["librevenge:sheet"]) {
+        str+=instr["librevenge:sheet"]->getStr().cstr();
+        str+='.';
+      }
+      appendCellReference(str, instr["librevenge:column"]->getInt(), instr["librevenge:column-absolute"] && instr["librevenge:column-absolute"]->getInt(),
+                          instr["librevenge:row"]->getInt(), instr["librevenge:row-absolute"] && instr["librevenge:row-absolute"]->getInt());
+    }
+    else if (type=="librevenge-cells" && instr["librevenge:start-column"] && instr["librevenge:start-row"] &&
+             instr["librevenge:end-column"] && instr["librevenge:end-row"]) {
+      if (instr["librevenge:sheet-name"]) {
+        str+=instr["librevenge:sheet-name"]->getStr().cstr();
+        str+='.';
+      }
+      appendCellReference(str, instr["librevenge:start-column"]->getInt(), instr["librevenge:start-column-absolute"] && instr["librevenge:start-column-absolute"]->getInt(),
+                          instr["librevenge:start-row"]->getInt(), instr["librevenge:start-row-absolute"] && instr["librevenge:start-row-absolute"]->getInt());
+      str+=':';
+      appendCellReference(str, instr["librevenge:end-column"]->getInt(), instr["librevenge:end-column-absolute"] && instr["librevenge:end-column-absolute"]->getInt(),
+                          instr["librevenge:end-row"]->getInt(), instr["librevenge:end-row-absolute"] && instr["librevenge:end-row-absolute"]->getInt());
+    }
+    else {
+      STOFF_DEBUG_MSG(("STOFFCSVSpreadsheetGeneratorInternal::State::appendFormula: unexpected instruction %s\n", type.cstr()));
+    }
+  }
+}
+
+void State::appendField(std::string &str, std::string const &field) const
+{
+  bool needSeparator=false;
+  for (auto c : field) {
+    if (c==m_fieldSeparator || c==m_textSeparator || c=='\n' || c=='\r') {
+      needSeparator=true;
+      break;
+    }
+  }
+  if (!needSeparator) {
+    str+=field;
+    return;
+  }
+  str+=m_textSeparator;
+  for (auto c : field) {
+    if (c==m_textSeparator) str+=c;
+    str+=c;
+  }
+  str+=m_textSeparator;
+}
+
+}
+
+STOFFCSVSpreadsheetGenerator::STOFFCSVSpreadsheetGenerator(int fd, STOFFDocument::CSVOptions const &options)
+  : librevenge::RVNGSpreadsheetInterface()
+  , m_state(new STOFFCSVSpreadsheetGeneratorInternal::State(fd, options))
+{
+}
+
+STOFFCSVSpreadsheetGenerator::~STOFFCSVSpreadsheetGenerator()
+{
+}
+
+int STOFFCSVSpreadsheetGenerator::getNumSheets() const
+{
+  return m_state->m_numSheets;
+}
+
+bool STOFFCSVSpreadsheetGenerator::flush()
+{
+  return m_state->flush();
+}
+
+void STOFFCSVSpreadsheetGenerator::setDocumentMetaData(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::startDocument(const ::librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::endDocument()
+{
+  m_state->flush();
+}
+
+//
+// page
+//
+void STOFFCSVSpreadsheetGenerator::definePageStyle(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::defineEmbeddedFont(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openPageSpan(const librevenge::RVNGPropertyList &)
+{
+}
+void STOFFCSVSpreadsheetGenerator::closePageSpan()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openHeader(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+void STOFFCSVSpreadsheetGenerator::closeHeader()
+{
+  --m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::openFooter(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+void STOFFCSVSpreadsheetGenerator::closeFooter()
+{
+  --m_state->m_subLevel;
+}
+
+//
+// spreadsheet
+//
+void STOFFCSVSpreadsheetGenerator::defineSheetNumberingStyle(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openSheet(const librevenge::RVNGPropertyList &)
+{
+  auto &state=*m_state;
+  state.m_isSheetSelected=state.m_numSheets++==state.m_sheetToConvert;
+  state.m_numEmptyRows=0;
+}
+
+void STOFFCSVSpreadsheetGenerator::closeSheet()
+{
+  // the last empty rows are not written
+  m_state->m_isSheetSelected=false;
+  m_state->m_numEmptyRows=0;
+  m_state->flush();
+}
+
+void STOFFCSVSpreadsheetGenerator::openSheetRow(const librevenge::RVNGPropertyList &propList)
+{
+  auto &state=*m_state;
+  if (!state.m_isSheetSelected) return;
+  state.m_row.clear();
+  state.m_numEmptyCells=0;
+  state.m_numRowsRepeated=propList["table:number-rows-repeated"] ? propList["table:number-rows-repeated"]->getInt() : 1;
+  if (state.m_numRowsRepeated<1) state.m_numRowsRepeated=1;
+}
+
+void STOFFCSVSpreadsheetGenerator::closeSheetRow()
+{
+  auto &state=*m_state;
+  if (!state.m_isSheetSelected) return;
+  if (state.m_row.empty()) {
+    state.m_numEmptyRows+=state.m_numRowsRepeated;
+    return;
+  }
+  state.m_buffer.append(size_t(state.m_numEmptyRows), '\n');
+  state.m_numEmptyRows=0;
+  for (int r=0; r<state.m_numRowsRepeated; ++r) {
+    state.m_buffer+=state.m_row;
+    state.m_buffer+='\n';
+  }
+  state.m_row.clear();
+  if (state.m_buffer.size()>=STOFFCSVSpreadsheetGeneratorInternal::s_bufferSize)
+    state.flush();
+}
+
+void STOFFCSVSpreadsheetGenerator::openSheetCell(const librevenge::RVNGPropertyList &propList)
+{
+  auto &state=*m_state;
+  if (!state.m_isSheetSelected) return;
+  state.m_isCellOpened=true;
+  state.m_cell.clear();
+  state.m_cellHasValue=false;
+  state.m_numParagraphs=0;
+  state.m_numCellsRepeated=propList["table:number-columns-repeated"] ? propList["table:number-columns-repeated"]->getInt() : 1;
+  if (state.m_numCellsRepeated<1) state.m_numCellsRepeated=1;
+
+  auto const *formula=propList.child("librevenge:formula");
+  if (state.m_generateFormula && formula && formula->count()) {
+    state.appendFormula(state.m_cell, *formula);
+    state.m_cellHasValue=true;
+    return;
+  }
+  if (!propList["librevenge:value-type"]) return;
+  std::string type(propList["librevenge:value-type"]->getStr().cstr());
+  if (type=="date" || type=="time") {
+    std::tm time;
+    std::memset(&time, 0, sizeof(time));
+    bool hasDate=propList["librevenge:year"] && propList["librevenge:month"] && propList["librevenge:day"];
+    bool hasTime=propList["librevenge:hours"] && propList["librevenge:minutes"] && propList["librevenge:seconds"];
+    if (hasDate) {
+      time.tm_year=propList["librevenge:year"]->getInt()-1900;
+      time.tm_mon=propList["librevenge:month"]->getInt()-1;
+      time.tm_mday=propList["librevenge:day"]->getInt();
+      state.appendDateTime(state.m_cell, state.m_dateFormat, time);
+    }
+    if (hasTime) {
+      time.tm_hour=propList["librevenge:hours"]->getInt();
+      time.tm_min=propList["librevenge:minutes"]->getInt();
+      time.tm_sec=propList["librevenge:seconds"]->getInt();
+      if (hasDate) state.m_cell+=' ';
+      state.appendDateTime(state.m_cell, state.m_timeFormat, time);
+    }
+    state.m_cellHasValue=hasDate || hasTime;
+    return;
+  }
+  if (!propList["librevenge:value"]) return;
+  double val=propList["librevenge:value"]->getDouble();
+  if (type=="boolean")
+    state.m_cell=(val<0 || val>0) ? "true" : "false";
+  else if (type=="percent") {
+    state.appendDouble(state.m_cell, 100.*val);
+    state.m_cell+='%';
+  }
+  else
+    state.appendDouble(state.m_cell, val);
+  state.m_cellHasValue=true;
+}
+
+void STOFFCSVSpreadsheetGenerator::closeSheetCell()
+{
+  auto &state=*m_state;
+  if (!state.m_isSheetSelected || !state.m_isCellOpened) return;
+  state.m_isCellOpened=false;
+  if (state.m_cell.empty()) {
+    state.m_numEmptyCells+=state.m_numCellsRepeated;
+    return;
+  }
+  // the first cell does not need a separator
+  int numSeparators=state.m_numEmptyCells+(state.m_row.empty() ? 0 : 1);
+  state.m_row.append(size_t(numSeparators), state.m_fieldSeparator);
+  state.m_numEmptyCells=0;
+  for (int c=0; c<state.m_numCellsRepeated; ++c) {
+    if (c) state.m_row+=state.m_fieldSeparator;
+    state.appendField(state.m_row, state.m_cell);
+  }
+}
+
+//
+// chart
+//
+void STOFFCSVSpreadsheetGenerator::defineChartStyle(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openChart(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::closeChart()
+{
+  --m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::openChartTextObject(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeChartTextObject()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openChartPlotArea(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeChartPlotArea()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::insertChartAxis(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openChartSerie(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeChartSerie()
+{
+}
+
+//
+// paragraph, span
+//
+void STOFFCSVSpreadsheetGenerator::defineParagraphStyle(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openParagraph(const librevenge::RVNGPropertyList &)
+{
+  if (!m_state->canWriteText()) return;
+  if (m_state->m_numParagraphs++)
+    m_state->m_cell+='\n';
+}
+
+void STOFFCSVSpreadsheetGenerator::closeParagraph()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::defineCharacterStyle(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openSpan(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeSpan()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openLink(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeLink()
+{
+}
+
+//
+// section, add basic char
+//
+void STOFFCSVSpreadsheetGenerator::defineSectionStyle(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openSection(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeSection()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::insertTab()
+{
+  if (m_state->canWriteText())
+    m_state->m_cell+='\t';
+}
+
+void STOFFCSVSpreadsheetGenerator::insertSpace()
+{
+  if (m_state->canWriteText())
+    m_state->m_cell+=' ';
+}
+
+void STOFFCSVSpreadsheetGenerator::insertText(const librevenge::RVNGString &text)
+{
+  if (m_state->canWriteText())
+    m_state->m_cell+=text.cstr();
+}
+
+void STOFFCSVSpreadsheetGenerator::insertLineBreak()
+{
+  if (m_state->canWriteText())
+    m_state->m_cell+='\n';
+}
+
+void STOFFCSVSpreadsheetGenerator::insertField(const librevenge::RVNGPropertyList &)
+{
+}
+
+//
+// list
+//
+void STOFFCSVSpreadsheetGenerator::openOrderedListLevel(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openUnorderedListLevel(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeOrderedListLevel()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeUnorderedListLevel()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openListElement(const librevenge::RVNGPropertyList &propList)
+{
+  openParagraph(propList);
+}
+
+void STOFFCSVSpreadsheetGenerator::closeListElement()
+{
+}
+
+//
+// footnote, comment, frame
+//
+void STOFFCSVSpreadsheetGenerator::openFootnote(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::closeFootnote()
+{
+  --m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::openComment(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+void STOFFCSVSpreadsheetGenerator::closeComment()
+{
+  --m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::openFrame(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+void STOFFCSVSpreadsheetGenerator::closeFrame()
+{
+  --m_state->m_subLevel;
+}
+void STOFFCSVSpreadsheetGenerator::insertBinaryObject(const librevenge::RVNGPropertyList &)
+{
+}
+
+//
+// specific text/table
+//
+void STOFFCSVSpreadsheetGenerator::openTextBox(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::closeTextBox()
+{
+  --m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::openTable(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+void STOFFCSVSpreadsheetGenerator::closeTable()
+{
+  --m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::openTableRow(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeTableRow()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::openTableCell(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::closeTableCell()
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::insertCoveredTableCell(const librevenge::RVNGPropertyList &)
+{
+}
+
+//
+// simple Graphic
+//
+void STOFFCSVSpreadsheetGenerator::openGroup(const librevenge::RVNGPropertyList &)
+{
+  ++m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::closeGroup()
+{
+  --m_state->m_subLevel;
+}
+
+void STOFFCSVSpreadsheetGenerator::defineGraphicStyle(const librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::drawRectangle(const ::librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::drawEllipse(const ::librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::drawPolygon(const ::librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::drawPolyline(const ::librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::drawPath(const ::librevenge::RVNGPropertyList &)
+{
+}
+
+void STOFFCSVSpreadsheetGenerator::drawConnector(const ::librevenge::RVNGPropertyList &)
+{
+}
+
+//
+// Equation
+//
+void STOFFCSVSpreadsheetGenerator::insertEquation(const ::librevenge::RVNGPropertyList &)
+{
+}
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
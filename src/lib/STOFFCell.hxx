@@ -63,6 +63,7 @@ public:
     Format()
       : m_format(F_UNKNOWN)
       , m_numberFormat(F_NUMBER_UNKNOWN)
+      , m_numberingStyleId(-1)
     {
     }
     //! destructor
@@ -83,6 +84,10 @@ public:
     FormatType m_format;
     //! the numeric format
     NumberType m_numberFormat;
+    /** an identifier of the cell's numbering style, unique in a document (or -1)
+
+        \note two cells with the same identifier have the same numbering style */
+    int m_numberingStyleId;
   };
   //! constructor
   STOFFCell()
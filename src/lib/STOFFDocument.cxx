@@ -41,12 +41,17 @@
 #include "SDWParser.hxx"
 #include "SDXParser.hxx"
 
+#include "STOFFCSVSpreadsheetGenerator.hxx"
 #include "STOFFHeader.hxx"
 #include "STOFFGraphicDecoder.hxx"
 #include "STOFFParser.hxx"
 #include "STOFFPropertyHandler.hxx"
 #include "STOFFSpreadsheetDecoder.hxx"
 
+#include "StarFileManager.hxx"
+#include "StarObject.hxx"
+#include "StarZone.hxx"
+
 #include <libstaroffice/libstaroffice.hxx>
 
 /** small namespace use to define private class/method used by STOFFDocument */
@@ -58,6 +63,20 @@ std::shared_ptr<STOFFTextParser> getTextParserFromHeader(STOFFInputStreamPtr &in
 std::shared_ptr<STOFFSpreadsheetParser> getSpreadsheetParserFromHeader(STOFFInputStreamPtr &input, STOFFHeader *header, char const *passwd);
 STOFFHeader *getHeader(STOFFInputStreamPtr &input, bool strict);
 bool checkHeader(STOFFInputStreamPtr &input, STOFFHeader &header, bool strict);
+//! calls function while checking the options' limits, throws a libstoff::AbortException if the parsing is aborted
+template <class Function> void callWithGuard(STOFFDocument::ParseOptions const &options, Function const &function)
+{
+  libstoff::ParseGuard guard(options.m_maxDuration, options.m_maxAllocationSize, options.m_cancelCallback, options.m_cancelData);
+  try {
+    function();
+  }
+  catch (...) {
+    // the parsers often transform the exceptions in a ParseException
+    if (guard.isAborted()) throw libstoff::AbortException();
+    throw;
+  }
+  if (guard.isAborted()) throw libstoff::AbortException();
+}
 }
 
 STOFFDocument::Confidence STOFFDocument::isFileFormatSupported(librevenge::RVNGInputStream *input, Kind &kind)
@@ -91,6 +110,13 @@ catch (...)
 }
 
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password)
+{
+  ParseOptions options;
+  options.m_password=password;
+  return parse(input, documentInterface, options);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options)
 try
 {
   if (!input)
@@ -100,9 +126,12 @@ try
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
-  auto parser=STOFFDocumentInternal::getGraphicParserFromHeader(ip, header.get(), password);
+  auto parser=STOFFDocumentInternal::getGraphicParserFromHeader(ip, header.get(), options.m_password);
   if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
+  parser->setSkipPictures(options.m_skipPictures);
+  STOFFDocumentInternal::callWithGuard(options, [&parser, documentInterface]() {
+    parser->parse(documentInterface);
+  });
   return STOFF_R_OK;
 }
 catch (libstoff::FileException)
@@ -115,6 +144,11 @@ catch (libstoff::ParseException)
   STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
   return STOFF_R_PARSE_ERROR;
 }
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
 catch (libstoff::WrongPasswordException)
 {
   STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
@@ -128,6 +162,13 @@ catch (...)
 }
 
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password)
+{
+  ParseOptions options;
+  options.m_password=password;
+  return parse(input, documentInterface, options);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, ParseOptions const &options)
 try
 {
   if (!input)
@@ -137,9 +178,12 @@ try
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
-  auto parser=STOFFDocumentInternal::getPresentationParserFromHeader(ip, header.get(), password);
+  auto parser=STOFFDocumentInternal::getPresentationParserFromHeader(ip, header.get(), options.m_password);
   if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
+  parser->setSkipPictures(options.m_skipPictures);
+  STOFFDocumentInternal::callWithGuard(options, [&parser, documentInterface]() {
+    parser->parse(documentInterface);
+  });
   return STOFF_R_OK;
 }
 catch (libstoff::FileException)
@@ -152,6 +196,11 @@ catch (libstoff::ParseException)
   STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
   return STOFF_R_PARSE_ERROR;
 }
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
 catch (libstoff::WrongPasswordException)
 {
   STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
@@ -165,6 +214,13 @@ catch (...)
 }
 
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password)
+{
+  ParseOptions options;
+  options.m_password=password;
+  return parse(input, documentInterface, options);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, ParseOptions const &options)
 try
 {
   if (!input)
@@ -174,9 +230,13 @@ try
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
-  auto parser=STOFFDocumentInternal::getSpreadsheetParserFromHeader(ip, header.get(), password);
+  auto parser=STOFFDocumentInternal::getSpreadsheetParserFromHeader(ip, header.get(), options.m_password);
   if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
+  parser->setSkipPictures(options.m_skipPictures);
+  parser->setUseThreads(options.m_useThreads);
+  STOFFDocumentInternal::callWithGuard(options, [&parser, documentInterface]() {
+    parser->parse(documentInterface);
+  });
   return STOFF_R_OK;
 }
 catch (libstoff::FileException)
@@ -189,6 +249,11 @@ catch (libstoff::ParseException)
   STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
   return STOFF_R_PARSE_ERROR;
 }
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
 catch (libstoff::WrongPasswordException)
 {
   STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
@@ -202,6 +267,13 @@ catch (...)
 }
 
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password)
+{
+  ParseOptions options;
+  options.m_password=password;
+  return parse(input, documentInterface, options);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options)
 try
 {
   if (!input)
@@ -211,10 +283,14 @@ try
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
-  auto parser=STOFFDocumentInternal::getTextParserFromHeader(ip, header.get(), password);
+  auto parser=STOFFDocumentInternal::getTextParserFromHeader(ip, header.get(), options.m_password);
   if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
-
+  parser->setSkipPictures(options.m_skipPictures);
+  parser->setSendProgressively(options.m_progressive);
+  parser->setUseThreads(options.m_useThreads);
+  STOFFDocumentInternal::callWithGuard(options, [&parser, documentInterface]() {
+    parser->parse(documentInterface);
+  });
   return STOFF_R_OK;
 }
 catch (libstoff::FileException)
@@ -227,6 +303,11 @@ catch (libstoff::ParseException)
   STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
   return STOFF_R_PARSE_ERROR;
 }
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
 catch (libstoff::WrongPasswordException)
 {
   STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
@@ -239,6 +320,384 @@ catch (...)
   return STOFF_R_UNKNOWN_ERROR;
 }
 
+STOFFDocument::Result STOFFDocument::parseToCSV(librevenge::RVNGInputStream *input, int fd, CSVOptions const &options, int &numSheets, char const *password)
+{
+  ParseOptions parseOptions;
+  parseOptions.m_password=password;
+  return parseToCSV(input, fd, options, numSheets, parseOptions);
+}
+
+STOFFDocument::Result STOFFDocument::parseToCSV(librevenge::RVNGInputStream *input, int fd, CSVOptions const &options, int &numSheets, ParseOptions const &parseOptions)
+try
+{
+  numSheets=0;
+  if (!input || fd<0)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
+  auto parser=STOFFDocumentInternal::getSpreadsheetParserFromHeader(ip, header.get(), parseOptions.m_password);
+  if (!parser) return STOFF_R_UNKNOWN_ERROR;
+  parser->setSkipPictures(parseOptions.m_skipPictures);
+  parser->setUseThreads(parseOptions.m_useThreads);
+  STOFFCSVSpreadsheetGenerator generator(fd, options);
+  STOFFDocumentInternal::callWithGuard(parseOptions, [&parser, &generator]() {
+    parser->parse(&generator);
+  });
+  numSheets=generator.getNumSheets();
+  if (!generator.flush())
+    return STOFF_R_FILE_ACCESS_ERROR;
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseToCSV: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseToCSV: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseToCSV: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseToCSV: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  STOFF_DEBUG_MSG(("STOFFDocument::parseToCSV: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::extractText(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password)
+{
+  ParseOptions options;
+  options.m_password=password;
+  return extractText(input, documentInterface, options);
+}
+
+STOFFDocument::Result STOFFDocument::extractText(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options)
+try
+{
+  if (!input || !documentInterface)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
+  switch (header->getKind()) {
+  case STOFFDocument::STOFF_K_TEXT: {
+    SDWParser parser(ip, header.get());
+    if (options.m_password) parser.setDocumentPassword(options.m_password);
+    parser.setUseThreads(options.m_useThreads);
+    STOFFDocumentInternal::callWithGuard(options, [&parser, documentInterface]() {
+      parser.extractText(documentInterface);
+    });
+    break;
+  }
+  case STOFFDocument::STOFF_K_SPREADSHEET: {
+    SDCParser parser(ip, header.get());
+    if (options.m_password) parser.setDocumentPassword(options.m_password);
+    parser.setUseThreads(options.m_useThreads);
+    STOFFDocumentInternal::callWithGuard(options, [&parser, documentInterface]() {
+      parser.extractText(documentInterface);
+    });
+    break;
+  }
+  case STOFFDocument::STOFF_K_DRAW:
+  case STOFFDocument::STOFF_K_PRESENTATION: {
+    SDAParser parser(ip, header.get());
+    if (options.m_password) parser.setDocumentPassword(options.m_password);
+    STOFFDocumentInternal::callWithGuard(options, [&parser, documentInterface]() {
+      parser.extractText(documentInterface);
+    });
+    break;
+  }
+  default:
+    STOFF_DEBUG_MSG(("STOFFDocument::extractText: unexpected document kind\n"));
+    return STOFF_R_UNKNOWN_ERROR;
+  }
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseMetaData(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &metaData, ParseOptions const &options)
+try
+{
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  if (!ip->isStructured())
+    return STOFF_R_OLE_ERROR;
+  // only retrieve the document information stream, the other streams are never read
+  auto info=ip->getSubStreamByName("SfxDocumentInfo");
+  if (!info) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parseMetaData: can not find the document information\n"));
+    return STOFF_R_PARSE_ERROR;
+  }
+  info->setReadInverted(true);
+  bool ok=false;
+  STOFFDocumentInternal::callWithGuard(options, [&ok, &info, &metaData]() {
+    ok=StarObject::readSfxDocumentInformation(info, "SfxDocumentInfo", metaData);
+  });
+  if (!ok)
+    return STOFF_R_PARSE_ERROR;
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseMetaData: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseMetaData: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseMetaData: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
+catch (...)
+{
+  //fixme: too generic
+  STOFF_DEBUG_MSG(("STOFFDocument::parseMetaData: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parsePages(librevenge::RVNGInputStream *input, PageInterfaceFactory &factory, ParseOptions const &options)
+try
+{
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
+  if (header->getKind()!=STOFF_K_DRAW && header->getKind()!=STOFF_K_PRESENTATION) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parsePages: unexpected document kind\n"));
+    return STOFF_R_UNKNOWN_ERROR;
+  }
+  SDAParser parser(ip, header.get());
+  if (options.m_password) parser.setDocumentPassword(options.m_password);
+  parser.setSkipPictures(options.m_skipPictures);
+  STOFFDocumentInternal::callWithGuard(options, [&parser, &factory]() {
+    parser.parsePages(factory);
+  });
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parsePages: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parsePages: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parsePages: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parsePages: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  STOFF_DEBUG_MSG(("STOFFDocument::parsePages: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseGalleryIndex(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyListVector &index, ParseOptions const &options)
+try
+{
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
+  if (header->getKind()!=STOFF_K_GRAPHIC) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryIndex: unexpected document kind\n"));
+    return STOFF_R_UNKNOWN_ERROR;
+  }
+  SDGParser parser(ip, header.get());
+  if (options.m_password) parser.setDocumentPassword(options.m_password);
+  STOFFDocumentInternal::callWithGuard(options, [&parser, &index]() {
+    parser.parseIndex(index);
+  });
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryIndex: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryIndex: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryIndex: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
+catch (...)
+{
+  //fixme: too generic
+  STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryIndex: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseGalleryItems(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyListVector const &index,
+    PageInterfaceFactory &factory, ParseOptions const &options)
+try
+{
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
+  if (header->getKind()!=STOFF_K_GRAPHIC) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryItems: unexpected document kind\n"));
+    return STOFF_R_UNKNOWN_ERROR;
+  }
+  SDGParser parser(ip, header.get());
+  if (options.m_password) parser.setDocumentPassword(options.m_password);
+  STOFFDocumentInternal::callWithGuard(options, [&parser, &index, &factory]() {
+    parser.parseItems(index, factory);
+  });
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryItems: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryItems: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryItems: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
+catch (...)
+{
+  //fixme: too generic
+  STOFF_DEBUG_MSG(("STOFFDocument::parseGalleryItems: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseThumbnail(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password)
+{
+  ParseOptions options;
+  options.m_password=password;
+  return parseThumbnail(input, documentInterface, options);
+}
+
+STOFFDocument::Result STOFFDocument::parseThumbnail(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options)
+try
+{
+  if (!input || !documentInterface)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  if (!ip->isStructured())
+    return STOFF_R_OLE_ERROR;
+  // only retrieve the preview stream, the other streams are never read
+  auto preview=ip->getSubStreamByName("SfxPreview");
+  if (!preview) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parseThumbnail: can not find the preview\n"));
+    return STOFF_R_PARSE_ERROR;
+  }
+  preview->setReadInverted(true);
+  StarZone zone(preview, "SfxPreview", "SfxPreview", options.m_password);
+  preview->seek(0, librevenge::RVNG_SEEK_SET);
+  bool ok=false;
+  STOFFDocumentInternal::callWithGuard(options, [&ok, &zone, documentInterface]() {
+    ok=StarFileManager::sendSVGDI(zone, documentInterface);
+  });
+  if (!ok)
+    return STOFF_R_PARSE_ERROR;
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseThumbnail: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseThumbnail: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::AbortException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseThumbnail: Abort exception trapped\n"));
+  return STOFF_R_ABORTED;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseThumbnail: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  STOFF_DEBUG_MSG(("STOFFDocument::parseThumbnail: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
 bool STOFFDocument::decodeGraphic(librevenge::RVNGBinaryData const &binary, librevenge::RVNGDrawingInterface *paintInterface)
 try
 {
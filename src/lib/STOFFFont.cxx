@@ -56,9 +56,12 @@ std::ostream &operator<<(std::ostream &o, STOFFFont const &font)
 
 int STOFFFont::cmp(STOFFFont const &font) const
 {
-  if (m_propertyList.getPropString() < font.m_propertyList.getPropString())
+  // getPropString serializes the list, so only call it once
+  librevenge::RVNGString const propString=m_propertyList.getPropString();
+  librevenge::RVNGString const fPropString=font.m_propertyList.getPropString();
+  if (propString < fPropString)
     return -1;
-  if (m_propertyList.getPropString() > font.m_propertyList.getPropString())
+  if (propString > fPropString)
     return 1;
   if (m_shadowColor < font.m_shadowColor)
     return -1;
@@ -73,6 +76,48 @@ int STOFFFont::cmp(STOFFFont const &font) const
   return 0;
 }
 
+bool STOFFFont::isEqual(STOFFFont const &font) const
+{
+  if (m_hyphen!=font.m_hyphen || m_softHyphen!=font.m_softHyphen || m_lineBreak!=font.m_lineBreak ||
+      m_shadowColor!=font.m_shadowColor)
+    return false;
+  int numEntries=0;
+  librevenge::RVNGPropertyList::Iter i(m_propertyList);
+  for (i.rewind(); i.next(); ++numEntries) {
+    if (i.child()) // unexpected, use the slow comparison
+      return cmp(font)==0;
+    auto const *prop=font.m_propertyList[i.key()];
+    if (!prop || !i() || i()->getStr()!=prop->getStr())
+      return false;
+  }
+  // font can not have less entries, check that it does not have more entries
+  librevenge::RVNGPropertyList::Iter fI(font.m_propertyList);
+  for (fI.rewind(); fI.next();) {
+    if (--numEntries<0) return false;
+  }
+  return true;
+}
+
+size_t STOFFFont::hash() const
+{
+  // FNV-1a on the keys and the values of the property list
+  uint64_t res=14695981039346656037ULL;
+  auto addString=[&res](char const *str) {
+    if (!str) return;
+    for (; *str; ++str)
+      res=(res^uint64_t(static_cast<unsigned char>(*str)))*1099511628211ULL;
+    res=(res^0xff)*1099511628211ULL;
+  };
+  librevenge::RVNGPropertyList::Iter i(m_propertyList);
+  for (i.rewind(); i.next();) {
+    addString(i.key());
+    if (i())
+      addString(i()->getStr().cstr());
+  }
+  res=31*res+uint64_t(m_shadowColor.value()&0xFFFFFF);
+  return size_t(8*res+(m_hyphen ? 4 : 0)+(m_softHyphen ? 2 : 0)+(m_lineBreak ? 1 : 0));
+}
+
 void STOFFFont::addTo(librevenge::RVNGPropertyList &pList) const
 {
   librevenge::RVNGPropertyList::Iter i(m_propertyList);
@@ -63,15 +63,19 @@ public:
   friend std::ostream &operator<<(std::ostream &o, STOFFFont const &font);
   //! a comparison function
   int cmp(STOFFFont const &font) const;
+  //! an equality function, faster than cmp: the property lists are compared entry by entry
+  bool isEqual(STOFFFont const &font) const;
+  //! returns a hash value of the font computed from the property entries: two equal fonts have the same hash value
+  size_t hash() const;
   //! operator==
   bool operator==(STOFFFont const &font) const
   {
-    return cmp(font)==0;
+    return isEqual(font);
   }
   //! operator!=
   bool operator!=(STOFFFont const &font) const
   {
-    return cmp(font)!=0;
+    return !isEqual(font);
   }
   //! operator<
   bool operator<(STOFFFont const &font) const
@@ -321,6 +321,19 @@ void STOFFGraphicListener::insertUnicode(uint32_t val)
   libstoff::appendUnicode(val, m_ps->m_textBuffer);
 }
 
+void STOFFGraphicListener::insertUnicodeRun(uint32_t const *characters, size_t num)
+{
+  if (!m_ps->isInTextZone()) {
+    STOFF_DEBUG_MSG(("STOFFGraphicListener::insertUnicodeRun: called outside a text zone\n"));
+    return;
+  }
+  // encode the run first: no span must be opened if all the characters are skipped
+  std::string run;
+  if (!libstoff::appendUnicode(characters, num, run)) return;
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  m_ps->m_textBuffer.append(run.c_str());
+}
+
 void STOFFGraphicListener::insertUnicodeString(librevenge::RVNGString const &str)
 {
   if (!m_ps->isInTextZone()) {
@@ -1145,6 +1158,7 @@ void STOFFGraphicListener::insertNote(STOFFNote const &, STOFFSubDocumentPtr &su
 ///////////////////
 void STOFFGraphicListener::insertPicture(STOFFPosition const &pos, STOFFEmbeddedObject const &picture, STOFFGraphicStyle const &style)
 {
+  if (m_skipPictures) return;
   if (!m_ds->m_isDocumentStarted) {
     STOFF_DEBUG_MSG(("STOFFGraphicListener::insertPicture: the document is not started\n"));
     return;
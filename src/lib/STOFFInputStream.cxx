@@ -360,45 +360,82 @@ bool STOFFInputStream::readCompressedLong(long &res)
   return false;
 }
 
-bool STOFFInputStream::readDouble8(double &res, bool &isNotANumber)
+namespace STOFFInputStreamInternal
 {
-  if (!m_stream) return false;
-  long pos=tell();
-  if (pos+8 > m_streamSize) return false;
+//! returns the 64 bits stored in data in big endian order
+static uint64_t getBigEndian64(uint8_t const *data)
+{
+  uint64_t res=0;
+  for (int i=0; i<8; ++i)
+    res=(res<<8)|uint64_t(data[i]);
+  return res;
+}
+//! returns the 64 bits stored in data in little endian order
+static uint64_t getLittleEndian64(uint8_t const *data)
+{
+  uint64_t res=0;
+  for (int i=7; i>=0; --i)
+    res=(res<<8)|uint64_t(data[i]);
+  return res;
+}
+//! returns the 16 or 32 bits value stored in data
+static unsigned long getULong(uint8_t const *data, int num, bool inverseRead)
+{
+  unsigned long res=0;
+  for (int i=0; i<num; ++i)
+    res=(res<<8)|static_cast<unsigned long>(data[inverseRead ? num-1-i : i]);
+  return res;
+}
+/** try to decode a IEEE 754 double: 1 bit sign, 11 bits exponent, 52 bits mantisse
 
+    \note the zero exponent is only accepted for (almost) zero or (almost)
+    normalized values, the 0x7ff exponent only for NaN (as in the original
+    readers)
+ */
+static bool decodeDouble(uint64_t bits, double &res, bool &isNotANumber)
+{
   isNotANumber=false;
   res=0;
-  int mantExp=int(readULong(1));
-  int val=int(readULong(1));
-  int exp=(mantExp<<4)+(val>>4);
-  double mantisse=double(val&0xF)/16.;
-  double factor=1./16/256.;
-  for (int j = 0; j < 6; ++j, factor/=256)
-    mantisse+=double(readULong(1))*factor;
-  int sign = 1;
-  if (exp & 0x800) {
-    exp &= 0x7ff;
-    sign = -1;
+  int const exp=int((bits>>52)&0x7ff);
+  uint64_t const mant=bits&((uint64_t(1)<<52)-1);
+  if (exp!=0 && exp!=0x7FF) {
+    if (std::numeric_limits<double>::is_iec559 && sizeof(double)==8)
+      std::memcpy(&res, &bits, 8);
+    else {
+      res=std::ldexp(double(mant|(uint64_t(1)<<52)), exp-0x3ff-52);
+      if (bits>>63)
+        res *= -1.;
+    }
+    return true;
   }
+  double const mantisse=std::ldexp(double(mant), -52);
   if (exp == 0) {
     if (mantisse <= 1.e-5 || mantisse >= 1-1.e-5)
       return true;
     // a Nan representation ?
     return false;
   }
-  if (exp == 0x7FF) {
-    if (mantisse >= 1.-1e-5) {
-      isNotANumber=true;
-      res=std::numeric_limits<double>::quiet_NaN();
-      return true; // ok 0x7FF and 0xFFF are nan
-    }
-    return false;
+  if (mantisse >= 1.-1e-5) {
+    isNotANumber=true;
+    res=std::numeric_limits<double>::quiet_NaN();
+    return true; // ok 0x7FF and 0xFFF are nan
   }
-  exp -= 0x3ff;
-  res = std::ldexp(1.+mantisse, exp);
-  if (sign == -1)
-    res *= -1.;
-  return true;
+  return false;
+}
+}
+
+bool STOFFInputStream::readDouble8(double &res, bool &isNotANumber)
+{
+  if (!m_stream) return false;
+  long pos=tell();
+  if (pos+8 > m_streamSize) return false;
+
+  isNotANumber=false;
+  res=0;
+  unsigned long numRead;
+  uint8_t const *data=m_stream->read(8, numRead);
+  if (!data || numRead!=8) return false;
+  return STOFFInputStreamInternal::decodeDouble(STOFFInputStreamInternal::getBigEndian64(data), res, isNotANumber);
 }
 
 bool STOFFInputStream::readDouble10(double &res, bool &isNotANumber)
@@ -407,36 +444,35 @@ bool STOFFInputStream::readDouble10(double &res, bool &isNotANumber)
   long pos=tell();
   if (pos+10 > m_streamSize) return false;
 
-  int exp = int(readULong(2));
-  int sign = 1;
-  if (exp & 0x8000) {
-    exp &= 0x7fff;
-    sign = -1;
-  }
+  isNotANumber=false;
+  unsigned long numRead;
+  uint8_t const *data=m_stream->read(10, numRead);
+  if (!data || numRead!=10) return false;
+  int exp = int(STOFFInputStreamInternal::getULong(data, 2, m_inverseRead));
+  bool const negative=(exp & 0x8000)!=0;
+  exp &= 0x7fff;
   exp -= 0x3fff;
 
-  isNotANumber=false;
-  unsigned long mantisse = static_cast<unsigned long>(readULong(4));
-  if ((mantisse & 0x80000001) == 0) {
+  auto const mantisse = STOFFInputStreamInternal::getULong(data+2, 4, m_inverseRead);
+  auto const mantisseLow = STOFFInputStreamInternal::getULong(data+6, 4, m_inverseRead);
+  if ((mantisse & 0x80000001) == 0 && mantisseLow == 0) {
     // unormalized number are not frequent, but can appear at least for date, ...
-    if (readULong(4) != 0)
-      seek(-4, librevenge::RVNG_SEEK_CUR);
-    else {
-      if (exp == -0x3fff && mantisse == 0) {
-        res=0;
-        return true; // ok zero
-      }
-      if (exp == 0x4000 && (mantisse & 0xFFFFFFL)==0) { // ok Nan
-        isNotANumber = true;
-        res=std::numeric_limits<double>::quiet_NaN();
-        return true;
-      }
-      return false;
+    if (exp == -0x3fff && mantisse == 0) {
+      res=0;
+      return true; // ok zero
+    }
+    if (exp == 0x4000 && (mantisse & 0xFFFFFFL)==0) { // ok Nan
+      isNotANumber = true;
+      res=std::numeric_limits<double>::quiet_NaN();
+      return true;
     }
+    return false;
   }
-  // or std::ldexp((total value)/double(0x80000000), exp);
-  res=std::ldexp(double(readULong(4)),exp-63)+std::ldexp(double(mantisse),exp-31);
-  if (sign == -1)
+  if (exp>-1000 && exp<1000) // the 64 bits mantisse can be converted with only one rounding
+    res=std::ldexp(double((uint64_t(mantisse)<<32)|uint64_t(mantisseLow)), exp-63);
+  else
+    res=std::ldexp(double(mantisseLow),exp-63)+std::ldexp(double(mantisse),exp-31);
+  if (negative)
     res *= -1.;
   return true;
 }
@@ -449,39 +485,53 @@ bool STOFFInputStream::readDoubleReverted8(double &res, bool &isNotANumber)
 
   isNotANumber=false;
   res=0;
-  int bytes[6];
-  for (int i=0; i<6; ++i) bytes[i]=int(readULong(1));
-
-  int val=int(readULong(1));
-  int mantExp=int(readULong(1));
-  int exp=(mantExp<<4)+(val>>4);
-  double mantisse=double(val&0xF)/16.;
-  double factor=1./16./256.;
-  for (int j = 0; j < 6; ++j, factor/=256)
-    mantisse+=double(bytes[5-j])*factor;
-  int sign = 1;
-  if (exp & 0x800) {
-    exp &= 0x7ff;
-    sign = -1;
-  }
-  if (exp == 0) {
-    if (mantisse <= 1.e-5 || mantisse >= 1-1.e-5)
-      return true;
-    // a Nan representation ?
+  unsigned long numRead;
+  uint8_t const *data=m_stream->read(8, numRead);
+  if (!data || numRead!=8) return false;
+  return STOFFInputStreamInternal::decodeDouble(STOFFInputStreamInternal::getLittleEndian64(data), res, isNotANumber);
+}
+
+bool STOFFInputStream::decodeDoubleReverted8(uint8_t const *data, double &res, bool &isNotANumber)
+{
+  isNotANumber=false;
+  res=0;
+  if (!data) return false;
+  return STOFFInputStreamInternal::decodeDouble(STOFFInputStreamInternal::getLittleEndian64(data), res, isNotANumber);
+}
+
+bool STOFFInputStream::readDoubles8(double *values, size_t n)
+{
+  return readDoubles(values, n, false);
+}
+
+bool STOFFInputStream::readDoublesReverted8(double *values, size_t n)
+{
+  return readDoubles(values, n, true);
+}
+
+bool STOFFInputStream::readDoubles(double *values, size_t n, bool reverted)
+{
+  if (!m_stream || (n && !values)) return false;
+  if (n==0) return true;
+  long pos=tell();
+  if (n>size_t(m_streamSize/8) || pos+8*long(n) > m_streamSize) return false;
+  libstoff::ParseGuard::checkAllocation(static_cast<unsigned long>(n), sizeof(double));
+
+  unsigned long numRead;
+  uint8_t const *data=m_stream->read(8*n, numRead);
+  if (!data || numRead!=8*n) {
+    STOFF_DEBUG_MSG(("STOFFInputStream::readDoubles: can not read the data\n"));
+    seek(pos+8*long(n), librevenge::RVNG_SEEK_SET);
     return false;
   }
-  if (exp == 0x7FF) {
-    if (mantisse >= 1.-1e-5) {
-      isNotANumber=true;
-      res=std::numeric_limits<double>::quiet_NaN();
-      return true; // ok 0x7FF and 0xFFF are nan
+  bool isNan;
+  for (size_t i=0; i<n; ++i, data+=8) {
+    uint64_t const bits=reverted ? STOFFInputStreamInternal::getLittleEndian64(data) : STOFFInputStreamInternal::getBigEndian64(data);
+    if (!STOFFInputStreamInternal::decodeDouble(bits, values[i], isNan)) {
+      STOFF_DEBUG_MSG(("STOFFInputStream::readDoubles: can not read a double\n"));
+      values[i]=0;
     }
-    return false;
   }
-  exp -= 0x3ff;
-  res = std::ldexp(1.+mantisse, exp);
-  if (sign == -1)
-    res *= -1.;
   return true;
 }
 
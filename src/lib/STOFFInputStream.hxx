@@ -186,8 +186,16 @@ public:
   bool readDouble8(double &res, bool &isNotANumber);
   //! try to read a double of size 8: 6.5 bytes mantisse, 1.5 bytes exponent
   bool readDoubleReverted8(double &res, bool &isNotANumber);
+  //! try to decode a double of size 8 stored in data: 6.5 bytes mantisse, 1.5 bytes exponent
+  static bool decodeDoubleReverted8(uint8_t const *data, double &res, bool &isNotANumber);
   //! try to read a double of size 10: 2 bytes exponent, 8 bytes mantisse
   bool readDouble10(double &res, bool &isNotANumber);
+  /** try to read n doubles of size 8 (see readDouble8) in values,
+      the non valid values are replaced by 0. Returns false if the data are not available */
+  bool readDoubles8(double *values, size_t n);
+  /** try to read n doubles of size 8 (see readDoubleReverted8) in values,
+      the non valid values are replaced by 0. Returns false if the data are not available */
+  bool readDoublesReverted8(double *values, size_t n);
   /**! reads numbytes data, WITHOUT using any endian or section consideration
    * \return a pointer to the read elements
    */
@@ -233,6 +241,8 @@ protected:
   void updateStreamSize();
   //! internal function used to read a byte
   static uint8_t readU8(librevenge::RVNGInputStream *stream);
+  //! internal function used to read n doubles of size 8
+  bool readDoubles(double *values, size_t n, bool reverted);
 
 private:
   STOFFInputStream(STOFFInputStream const &orig);
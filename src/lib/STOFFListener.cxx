@@ -40,6 +40,7 @@
 
 STOFFListener::STOFFListener(STOFFListManagerPtr listManager)
   : m_listManager(listManager)
+  , m_skipPictures(false)
 {
   if (!m_listManager)
     m_listManager.reset(new STOFFListManager);
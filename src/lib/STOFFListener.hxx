@@ -68,6 +68,16 @@ public:
   {
     return m_listManager;
   }
+  /** sets the skip pictures flag: if set, insertPicture does nothing */
+  void setSkipPictures(bool skip)
+  {
+    m_skipPictures=skip;
+  }
+  /** returns true if the pictures must be ignored */
+  bool skipPictures() const
+  {
+    return m_skipPictures;
+  }
   // ------ main document -------
   /** sets the documents language */
   virtual void setDocumentLanguage(std::string locale) = 0;
@@ -110,16 +120,24 @@ public:
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   virtual void insertUnicode(uint32_t character)=0;
+  /** adds a run of unicode characters which must not contain any tab or end of line.
+   *  As in insertUnicode, the characters 0xfffd(undef) are ignored */
+  virtual void insertUnicodeRun(uint32_t const *characters, size_t num)=0;
   /** try to insert a list of unicode character */
   void insertUnicodeList(std::vector<uint32_t> const &list)
   {
     if (list.empty() || !canWriteText())
       return;
+    size_t runStart=0;
     for (size_t i=0; i<list.size(); ++i) {
+      if (list[i]!=0x9 && list[i]!=0xa && list[i]!=0xc)
+        continue;
+      if (i>runStart) insertUnicodeRun(&list[runStart], i-runStart);
+      runStart=i+1;
       if (list[i]==0x9) insertTab();
-      else if (list[i]==0xa || list[i]==0xc) insertEOL(); // checkme: use softBreak ?
-      else insertUnicode(list[i]);
+      else insertEOL(); // checkme: use softBreak ?
     }
+    if (list.size()>runStart) insertUnicodeRun(&list[runStart], list.size()-runStart);
   }
   //! adds a unicode string
   virtual void insertUnicodeString(librevenge::RVNGString const &str)=0;
@@ -245,6 +263,8 @@ protected:
   explicit STOFFListener(STOFFListManagerPtr listManager);
   /// the list manager
   STOFFListManagerPtr m_listManager;
+  /// a flag to know if we ignore the pictures
+  bool m_skipPictures;
 };
 
 #endif
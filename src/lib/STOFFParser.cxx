@@ -51,6 +51,9 @@ STOFFParserState::STOFFParserState(STOFFParserState::Type type, STOFFInputStream
   , m_graphicListener()
   , m_spreadsheetListener()
   , m_textListener()
+  , m_skipPictures(false)
+  , m_sendProgressively(false)
+  , m_useThreads(false)
   , m_asciiFile(input)
 {
   if (header) {
@@ -78,6 +81,7 @@ STOFFParser::~STOFFParser()
 void STOFFParser::setGraphicListener(STOFFGraphicListenerPtr &listener)
 {
   m_parserState->m_graphicListener=listener;
+  if (listener) listener->setSkipPictures(m_parserState->m_skipPictures);
 }
 
 void STOFFParser::resetGraphicListener()
@@ -89,6 +93,7 @@ void STOFFParser::resetGraphicListener()
 void STOFFParser::setSpreadsheetListener(STOFFSpreadsheetListenerPtr &listener)
 {
   m_parserState->m_spreadsheetListener=listener;
+  if (listener) listener->setSkipPictures(m_parserState->m_skipPictures);
 }
 
 void STOFFParser::resetSpreadsheetListener()
@@ -100,6 +105,7 @@ void STOFFParser::resetSpreadsheetListener()
 void STOFFParser::setTextListener(STOFFTextListenerPtr &listener)
 {
   m_parserState->m_textListener=listener;
+  if (listener) listener->setSkipPictures(m_parserState->m_skipPictures);
 }
 
 void STOFFParser::resetTextListener()
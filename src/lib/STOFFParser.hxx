@@ -76,6 +76,12 @@ public:
   STOFFSpreadsheetListenerPtr m_spreadsheetListener;
   //! the text listener
   STOFFTextListenerPtr m_textListener;
+  //! a flag to know if the pictures must be ignored
+  bool m_skipPictures;
+  //! a flag to know if the text must be sent as soon as it is read
+  bool m_sendProgressively;
+  //! a flag to know if the independent zones can be read in several threads
+  bool m_useThreads;
 
   //! the debug file
   libstoff::DebugFile m_asciiFile;
@@ -139,6 +145,21 @@ public:
   {
     return m_parserState->m_textListener;
   }
+  //! sets the skip pictures flag: if set, no picture is sent to the listeners
+  void setSkipPictures(bool skip)
+  {
+    m_parserState->m_skipPictures=skip;
+  }
+  //! sets the progressive flag: if set, the text is sent as soon as it is read (if possible)
+  void setSendProgressively(bool progressive)
+  {
+    m_parserState->m_sendProgressively=progressive;
+  }
+  //! sets the threads flag: if set, the independent zones can be read in several threads
+  void setUseThreads(bool useThreads)
+  {
+    m_parserState->m_useThreads=useThreads;
+  }
   //! a DebugFile used to write what we recognize when we parse the document
   libstoff::DebugFile &ascii()
   {
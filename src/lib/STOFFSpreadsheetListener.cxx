@@ -88,6 +88,7 @@ struct DocumentState {
     , m_isSheetRowOpened(false)
     , m_sentListMarkers()
     , m_numberingIdMap()
+    , m_styleIdToNumberingIdList()
     , m_subDocuments()
     , m_definedFontStyleSet()
     , m_definedGraphicStyleSet()
@@ -117,6 +118,8 @@ struct DocumentState {
   std::vector<int> m_sentListMarkers;
   /** a map cell's format to id */
   std::map<librevenge::RVNGString,int> m_numberingIdMap;
+  /** a list cell's format numbering style id to id (or -1) */
+  std::vector<int> m_styleIdToNumberingIdList;
   std::vector<STOFFSubDocumentPtr> m_subDocuments; /** list of document actually open */
   //! the set of defined font style
   std::set<librevenge::RVNGString> m_definedFontStyleSet;
@@ -335,6 +338,20 @@ void STOFFSpreadsheetListener::insertUnicode(uint32_t val)
   libstoff::appendUnicode(val, m_ps->m_textBuffer);
 }
 
+void STOFFSpreadsheetListener::insertUnicodeRun(uint32_t const *characters, size_t num)
+{
+  if (!m_ps->canWriteText()) {
+    STOFF_DEBUG_MSG(("STOFFSpreadsheetListener::insertUnicodeRun: called outside a text zone\n"));
+    return;
+  }
+  // encode the run first: no span must be opened if all the characters are skipped
+  std::string run;
+  if (!libstoff::appendUnicode(characters, num, run)) return;
+  _flushDeferredTabs();
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  m_ps->m_textBuffer.append(run.c_str());
+}
+
 void STOFFSpreadsheetListener::insertUnicodeString(librevenge::RVNGString const &str)
 {
   if (!m_ps->canWriteText()) {
@@ -1079,6 +1096,7 @@ void STOFFSpreadsheetListener::insertTextBox
 
 void STOFFSpreadsheetListener::insertPicture(STOFFPosition const &pos, STOFFEmbeddedObject const &picture, STOFFGraphicStyle const &style)
 {
+  if (m_skipPictures) return;
   if (!m_ds->m_isSheetOpened) {
     STOFF_DEBUG_MSG(("STOFFSpreadsheetListener::insertPicture insert a picture outside a sheet is not implemented\n"));
     return;
@@ -1441,24 +1459,35 @@ void STOFFSpreadsheetListener::openSheetCell(STOFFCell const &cell, STOFFCellCon
   STOFFCell::Format const &format=cell.getFormat();
   if (!format.hasBasicFormat()) {
     int numberingId=-1;
-    librevenge::RVNGPropertyList const &numberingStyle=cell.getNumberingStyle();
-    librevenge::RVNGString hashKey = numberingStyle.getPropString();
-    std::stringstream name;
-    if (m_ds->m_numberingIdMap.find(hashKey)!=m_ds->m_numberingIdMap.end()) {
-      numberingId=m_ds->m_numberingIdMap.find(hashKey)->second;
-      name << "Numbering" << numberingId;
+    auto const styleId=size_t(format.m_numberingStyleId);
+    if (format.m_numberingStyleId>=0 && styleId<m_ds->m_styleIdToNumberingIdList.size())
+      numberingId=m_ds->m_styleIdToNumberingIdList[styleId];
+    if (numberingId<0) {
+      librevenge::RVNGPropertyList const &numberingStyle=cell.getNumberingStyle();
+      librevenge::RVNGString hashKey = numberingStyle.getPropString();
+      if (m_ds->m_numberingIdMap.find(hashKey)!=m_ds->m_numberingIdMap.end())
+        numberingId=m_ds->m_numberingIdMap.find(hashKey)->second;
+      else if (!numberingStyle.empty()) {
+        numberingId=int(m_ds->m_numberingIdMap.size());
+        librevenge::RVNGString name;
+        name.sprintf("Numbering%d", numberingId);
+
+        librevenge::RVNGPropertyList numList(numberingStyle);
+        numList.insert("librevenge:name", name);
+        m_documentInterface->defineSheetNumberingStyle(numList);
+        m_ds->m_numberingIdMap[hashKey]=numberingId;
+      }
+      if (numberingId>=0 && format.m_numberingStyleId>=0) {
+        if (styleId>=m_ds->m_styleIdToNumberingIdList.size())
+          m_ds->m_styleIdToNumberingIdList.resize(styleId+1, -1);
+        m_ds->m_styleIdToNumberingIdList[styleId]=numberingId;
+      }
     }
-    else if (!numberingStyle.empty()) {
-      numberingId=int(m_ds->m_numberingIdMap.size());
-      name << "Numbering" << numberingId;
-
-      librevenge::RVNGPropertyList numList(numberingStyle);
-      numList.insert("librevenge:name", name.str().c_str());
-      m_documentInterface->defineSheetNumberingStyle(numList);
-      m_ds->m_numberingIdMap[hashKey]=numberingId;
+    if (numberingId>=0) {
+      librevenge::RVNGString name;
+      name.sprintf("Numbering%d", numberingId);
+      propList.insert("librevenge:numbering-name", name);
     }
-    if (numberingId>=0)
-      propList.insert("librevenge:numbering-name", name.str().c_str());
   }
   // formula
   if (content.m_formula.size()) {
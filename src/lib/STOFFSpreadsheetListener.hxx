@@ -153,6 +153,8 @@ public:
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   void insertUnicode(uint32_t character) final;
+  /** adds a run of unicode characters (without tab and end of line) */
+  void insertUnicodeRun(uint32_t const *characters, size_t num) final;
   //! adds a unicode string
   void insertUnicodeString(librevenge::RVNGString const &str) final;
 
@@ -20,6 +20,7 @@
 */
 
 #include <cstring>
+#include <memory>
 #include <vector>
 
 #include <librevenge-stream/librevenge-stream.h>
@@ -32,12 +33,14 @@ class STOFFStringStreamPrivate
 public:
   //! constructor
   STOFFStringStreamPrivate(const unsigned char *data, unsigned dataSize);
+  //! constructor from a shared buffer
+  explicit STOFFStringStreamPrivate(std::shared_ptr<std::vector<unsigned char> > const &data);
   //! destructor
   ~STOFFStringStreamPrivate();
   //! append some data at the end of the actual stream
   void append(const unsigned char *data, unsigned dataSize);
   //! the stream buffer
-  std::vector<unsigned char> m_buffer;
+  std::shared_ptr<std::vector<unsigned char> > m_buffer;
   //! the stream offset
   long m_offset;
 private:
@@ -46,10 +49,16 @@ private:
 };
 
 STOFFStringStreamPrivate::STOFFStringStreamPrivate(const unsigned char *data, unsigned dataSize)
-  : m_buffer(dataSize)
+  : m_buffer(new std::vector<unsigned char>(dataSize))
+  , m_offset(0)
+{
+  std::memcpy(&(*m_buffer)[0], data, dataSize);
+}
+
+STOFFStringStreamPrivate::STOFFStringStreamPrivate(std::shared_ptr<std::vector<unsigned char> > const &data)
+  : m_buffer(data ? data : std::make_shared<std::vector<unsigned char> >())
   , m_offset(0)
 {
-  std::memcpy(&m_buffer[0], data, dataSize);
 }
 
 STOFFStringStreamPrivate::~STOFFStringStreamPrivate()
@@ -59,9 +68,11 @@ STOFFStringStreamPrivate::~STOFFStringStreamPrivate()
 void STOFFStringStreamPrivate::append(const unsigned char *data, unsigned dataSize)
 {
   if (!dataSize) return;
-  size_t actualSize=m_buffer.size();
-  m_buffer.resize(actualSize+size_t(dataSize));
-  std::memcpy(&m_buffer[actualSize], data, dataSize);
+  if (m_buffer.use_count()!=1) // the buffer is shared, we must copy it
+    m_buffer=std::make_shared<std::vector<unsigned char> >(*m_buffer);
+  size_t actualSize=m_buffer->size();
+  m_buffer->resize(actualSize+size_t(dataSize));
+  std::memcpy(&(*m_buffer)[actualSize], data, dataSize);
 }
 
 STOFFStringStream::STOFFStringStream(const unsigned char *data, const unsigned int dataSize) :
@@ -70,6 +81,12 @@ STOFFStringStream::STOFFStringStream(const unsigned char *data, const unsigned i
 {
 }
 
+STOFFStringStream::STOFFStringStream(std::shared_ptr<std::vector<unsigned char> > const &data) :
+  librevenge::RVNGInputStream(),
+  m_data(new STOFFStringStreamPrivate(data))
+{
+}
+
 STOFFStringStream::~STOFFStringStream()
 {
   if (m_data) delete m_data;
@@ -89,10 +106,10 @@ const unsigned char *STOFFStringStream::read(unsigned long numBytes, unsigned lo
 
   long numBytesToRead;
 
-  if (static_cast<unsigned long>(m_data->m_offset)+numBytes < m_data->m_buffer.size())
+  if (static_cast<unsigned long>(m_data->m_offset)+numBytes < m_data->m_buffer->size())
     numBytesToRead = long(numBytes);
   else
-    numBytesToRead = long(m_data->m_buffer.size()) - m_data->m_offset;
+    numBytesToRead = long(m_data->m_buffer->size()) - m_data->m_offset;
 
   numBytesRead = static_cast<unsigned long>(numBytesToRead); // about as paranoid as we can be..
 
@@ -102,7 +119,7 @@ const unsigned char *STOFFStringStream::read(unsigned long numBytes, unsigned lo
   long oldOffset = m_data->m_offset;
   m_data->m_offset += numBytesToRead;
 
-  return &m_data->m_buffer[size_t(oldOffset)];
+  return &(*m_data->m_buffer)[size_t(oldOffset)];
 
 }
 
@@ -119,14 +136,14 @@ int STOFFStringStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
   else if (seekType == librevenge::RVNG_SEEK_SET)
     m_data->m_offset = offset;
   else if (seekType == librevenge::RVNG_SEEK_END)
-    m_data->m_offset = offset+long(m_data->m_buffer.size());
+    m_data->m_offset = offset+long(m_data->m_buffer->size());
 
   if (m_data->m_offset < 0) {
     m_data->m_offset = 0;
     return -1;
   }
-  if (long(m_data->m_offset) > long(m_data->m_buffer.size())) {
-    m_data->m_offset = long(m_data->m_buffer.size());
+  if (long(m_data->m_offset) > long(m_data->m_buffer->size())) {
+    m_data->m_offset = long(m_data->m_buffer->size());
     return -1;
   }
 
@@ -135,7 +152,7 @@ int STOFFStringStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
 
 bool STOFFStringStream::isEnd()
 {
-  if (!m_data || long(m_data->m_offset) >= long(m_data->m_buffer.size()))
+  if (!m_data || long(m_data->m_offset) >= long(m_data->m_buffer->size()))
     return true;
 
   return false;
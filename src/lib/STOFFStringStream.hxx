@@ -22,6 +22,9 @@
 #ifndef STOFF_STRING_STREAM_HXX
 #define STOFF_STRING_STREAM_HXX
 
+#include <memory>
+#include <vector>
+
 #include <librevenge-stream/librevenge-stream.h>
 
 class STOFFStringStreamPrivate;
@@ -36,6 +39,11 @@ class STOFFStringStream final: public librevenge::RVNGInputStream
 public:
   //! constructor
   STOFFStringStream(const unsigned char *data, const unsigned int dataSize);
+  /** constructor from a shared buffer
+
+      \note the buffer is not copied, so several streams, each with its own
+      position, can read it simultaneously */
+  explicit STOFFStringStream(std::shared_ptr<std::vector<unsigned char> > const &data);
   //! destructor
   ~STOFFStringStream() final;
 
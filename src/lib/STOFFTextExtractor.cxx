@@ -0,0 +1,153 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libstaroffice
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2002 William Lachance (wrlach@gmail.com)
+* Copyright (C) 2002,2004 Marc Maurer (uwog@uwog.net)
+* Copyright (C) 2004-2006 Fridrich Strba (fridrich.strba@bluewin.ch)
+* Copyright (C) 2006, 2007 Andrew Ziem
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+
+#include <librevenge/librevenge.h>
+
+#include "libstaroffice_internal.hxx"
+
+#include "STOFFTextExtractor.hxx"
+
+STOFFTextExtractor::STOFFTextExtractor(librevenge::RVNGTextInterface *documentInterface)
+  : m_documentInterface(documentInterface)
+  , m_isDocumentStarted(false)
+  , m_isParagraphOpened(false)
+  , m_text()
+{
+}
+
+STOFFTextExtractor::~STOFFTextExtractor()
+{
+  if (m_isDocumentStarted)
+    endDocument();
+}
+
+void STOFFTextExtractor::startDocument(librevenge::RVNGPropertyList const &metaData)
+{
+  if (m_isDocumentStarted || !m_documentInterface) {
+    STOFF_DEBUG_MSG(("STOFFTextExtractor::startDocument: the document is already started\n"));
+    return;
+  }
+  m_documentInterface->setDocumentMetaData(metaData);
+  m_documentInterface->startDocument(librevenge::RVNGPropertyList());
+  m_documentInterface->openPageSpan(librevenge::RVNGPropertyList());
+  m_isDocumentStarted=true;
+}
+
+void STOFFTextExtractor::endDocument()
+{
+  if (!m_isDocumentStarted) {
+    STOFF_DEBUG_MSG(("STOFFTextExtractor::endDocument: the document is not started\n"));
+    return;
+  }
+  closeParagraph();
+  m_documentInterface->closePageSpan();
+  m_documentInterface->endDocument();
+  m_isDocumentStarted=false;
+}
+
+void STOFFTextExtractor::openParagraph(int outlineLevel)
+{
+  if (!m_isDocumentStarted) {
+    STOFF_DEBUG_MSG(("STOFFTextExtractor::openParagraph: the document is not started\n"));
+    return;
+  }
+  closeParagraph();
+  if (outlineLevel>0) {
+    librevenge::RVNGPropertyList propList;
+    propList.insert("text:outline-level", outlineLevel);
+    m_documentInterface->openParagraph(propList);
+  }
+  else
+    m_documentInterface->openParagraph(librevenge::RVNGPropertyList());
+  m_isParagraphOpened=true;
+}
+
+void STOFFTextExtractor::closeParagraph()
+{
+  if (!m_isParagraphOpened) return;
+  flushText();
+  m_documentInterface->closeParagraph();
+  m_isParagraphOpened=false;
+}
+
+void STOFFTextExtractor::flushText()
+{
+  if (m_text.empty()) return;
+  m_documentInterface->openSpan(librevenge::RVNGPropertyList());
+  m_documentInterface->insertText(m_text);
+  m_documentInterface->closeSpan();
+  m_text.clear();
+}
+
+void STOFFTextExtractor::insertUnicode(uint32_t character)
+{
+  if (!m_isParagraphOpened) {
+    if (!m_isDocumentStarted) return;
+    openParagraph();
+  }
+  switch (character) {
+  case 0x9:
+    flushText();
+    m_documentInterface->insertTab();
+    break;
+  case 0xa:
+    flushText();
+    m_documentInterface->insertLineBreak();
+    break;
+  default:
+    // the other control characters are field/footnote/... anchors
+    if (character<0x20 || character==0xfeff || character==0xfffe || character==0xffff)
+      break;
+    libstoff::appendUnicode(character, m_text);
+    break;
+  }
+}
+
+void STOFFTextExtractor::insertUnicodeList(std::vector<uint32_t> const &list)
+{
+  for (auto c : list)
+    insertUnicode(c);
+}
+
+void STOFFTextExtractor::insertUnicodeString(librevenge::RVNGString const &str)
+{
+  if (str.empty()) return;
+  if (!m_isParagraphOpened) {
+    if (!m_isDocumentStarted) return;
+    openParagraph();
+  }
+  m_text.append(str);
+}
+
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -0,0 +1,100 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libstaroffice
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2002 William Lachance (wrlach@gmail.com)
+* Copyright (C) 2002,2004 Marc Maurer (uwog@uwog.net)
+* Copyright (C) 2004-2006 Fridrich Strba (fridrich.strba@bluewin.ch)
+* Copyright (C) 2006, 2007 Andrew Ziem
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+
+#ifndef STOFF_TEXT_EXTRACTOR_HXX
+#define STOFF_TEXT_EXTRACTOR_HXX
+
+#include <vector>
+
+#include <librevenge/librevenge.h>
+
+#include "libstaroffice_internal.hxx"
+
+/** small class used to send only the text content of a document to a
+    librevenge::RVNGTextInterface, \see STOFFDocument::extractText
+
+    Contrary to the listeners, it does not retrieve any style, page span
+    or picture: it only creates paragraphs(with eventually an outline level)
+    containing text, tabs and line breaks.
+*/
+class STOFFTextExtractor
+{
+public:
+  //! constructor
+  explicit STOFFTextExtractor(librevenge::RVNGTextInterface *documentInterface);
+  //! destructor
+  ~STOFFTextExtractor();
+  //! starts the document: sends the meta data and opens a default page span
+  void startDocument(librevenge::RVNGPropertyList const &metaData);
+  //! ends the document
+  void endDocument();
+  /** opens a new paragraph: a positive outline level means that the
+      paragraph is a heading */
+  void openParagraph(int outlineLevel=0);
+  //! closes the current paragraph (if a paragraph is opened)
+  void closeParagraph();
+  //! adds a unicode character, opens a paragraph if needed
+  void insertUnicode(uint32_t character);
+  //! adds a list of unicode characters, opens a paragraph if needed
+  void insertUnicodeList(std::vector<uint32_t> const &list);
+  //! adds an utf8 string, opens a paragraph if needed
+  void insertUnicodeString(librevenge::RVNGString const &str);
+  //! adds a paragraph which contains a list of unicode characters(if the list is not empty)
+  void insertParagraph(std::vector<uint32_t> const &list, int outlineLevel=0)
+  {
+    if (list.empty()) return;
+    openParagraph(outlineLevel);
+    insertUnicodeList(list);
+    closeParagraph();
+  }
+
+protected:
+  //! sends the text stored in the buffer
+  void flushText();
+
+  //! the document interface
+  librevenge::RVNGTextInterface *m_documentInterface;
+  //! a flag to know if the document is started
+  bool m_isDocumentStarted;
+  //! a flag to know if a paragraph is opened
+  bool m_isParagraphOpened;
+  //! the text which is not yet sent
+  librevenge::RVNGString m_text;
+
+private:
+  STOFFTextExtractor(STOFFTextExtractor const &) = delete;
+  STOFFTextExtractor &operator=(STOFFTextExtractor const &) = delete;
+};
+#endif
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -38,10 +38,12 @@
  * the librevenge::RVNGTextInterface
  */
 
+#include <algorithm>
 #include <cstring>
 #include <iomanip>
 #include <set>
 #include <sstream>
+#include <unordered_map>
 #include <time.h>
 
 #include <librevenge/librevenge.h>
@@ -69,6 +71,28 @@ namespace STOFFTextListenerInternal
 {
 //! a enum to define basic break bit
 enum { PageBreakBit=0x1, ColumnBreakBit=0x2 };
+//! a span style: a font and the property list sent to the interface
+struct SpanStyle {
+  //! constructor
+  SpanStyle(STOFFFont const &font, size_t hash)
+    : m_font(font)
+    , m_hash(hash)
+    , m_propertyList()
+    , m_propertyString()
+  {
+    m_font.addTo(m_propertyList);
+    STOFFFont::checkForDefault(m_propertyList);
+    m_propertyString=m_propertyList.getPropString();
+  }
+  //! the font
+  STOFFFont m_font;
+  //! the font hash value
+  size_t m_hash;
+  //! the property list sent to openSpan
+  librevenge::RVNGPropertyList m_propertyList;
+  //! the serialized property list, used to compare two spans
+  librevenge::RVNGString m_propertyString;
+};
 //! a class to store the document state of a STOFFTextListener
 struct TextState {
   //! constructor
@@ -88,6 +112,7 @@ struct TextState {
     , m_definedFontStyleSet()
     , m_definedGraphicStyleSet()
     , m_definedParagraphStyleSet()
+    , m_spanStyleCache()
   {
   }
   //! destructor
@@ -116,6 +141,8 @@ struct TextState {
   std::set<librevenge::RVNGString> m_definedGraphicStyleSet;
   //! the set of defined paragraph style
   std::set<librevenge::RVNGString> m_definedParagraphStyleSet;
+  //! the span styles already created: font hash value -> span style
+  std::unordered_multimap<size_t, std::shared_ptr<SpanStyle> > m_spanStyleCache;
 
 private:
   TextState(const TextState &);
@@ -136,6 +163,8 @@ struct State {
 
   //! the font
   STOFFFont m_font;
+  //! the span style corresponding to m_font (or null if it is not computed)
+  std::shared_ptr<SpanStyle> m_spanStyle;
   //! the paragraph
   STOFFParagraph m_paragraph;
   //! a sequence of bit used to know if we need page/column break
@@ -188,6 +217,7 @@ State::State()
   , m_numDeferredTabs(0)
 
   , m_font()
+  , m_spanStyle()
 
   , m_paragraph()
   , m_paragraphNeedBreak(0)
@@ -314,6 +344,16 @@ void STOFFTextListener::insertUnicode(uint32_t val)
   libstoff::appendUnicode(val, m_ps->m_textBuffer);
 }
 
+void STOFFTextListener::insertUnicodeRun(uint32_t const *characters, size_t num)
+{
+  // encode the run first: no span must be opened if all the characters are skipped
+  std::string run;
+  if (!libstoff::appendUnicode(characters, num, run)) return;
+  _flushDeferredTabs();
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  m_ps->m_textBuffer.append(run.c_str());
+}
+
 void STOFFTextListener::insertUnicodeString(librevenge::RVNGString const &str)
 {
   _flushDeferredTabs();
@@ -418,10 +458,19 @@ void STOFFTextListener::_insertBreakIfNecessary(librevenge::RVNGPropertyList &pr
 ///////////////////
 void STOFFTextListener::setFont(STOFFFont const &font)
 {
-  if (font == m_ps->m_font) return;
+  size_t hash=font.hash();
+  // the span style stores the current font and its hash value
+  if (m_ps->m_spanStyle) {
+    if (m_ps->m_spanStyle->m_hash==hash && m_ps->m_spanStyle->m_font==font) return;
+  }
+  else if (font == m_ps->m_font) return;
 
-  _closeSpan();
+  auto style=_getSpanStyle(font, hash);
+  // the span does not need to be reopened if its properties are unchanged
+  if (!m_ps->m_spanStyle || m_ps->m_spanStyle->m_propertyString!=style->m_propertyString)
+    _closeSpan();
   m_ps->m_font = font;
+  m_ps->m_spanStyle = style;
 }
 
 STOFFFont const &STOFFTextListener::getFont() const
@@ -495,6 +544,31 @@ void STOFFTextListener::closeLink()
 ///////////////////
 // document
 ///////////////////
+void STOFFTextListener::setPageSpans(std::vector<STOFFPageSpan> const &pageList)
+{
+  if (pageList.empty()) {
+    STOFF_DEBUG_MSG(("STOFFTextListener::setPageSpans: called with an empty list\n"));
+    return;
+  }
+  if (m_ps->m_isPageSpanOpened) {
+    // retrieve the current span in the new list and update its number of remaining pages
+    int numSentPages=m_ds->m_pageSpan.m_pageSpan-1-m_ps->m_numPagesRemainingInSpan;
+    unsigned actPage = 0;
+    auto it = pageList.begin();
+    while (true) {
+      actPage+=static_cast<unsigned>(it->m_pageSpan);
+      if (actPage>=m_ps->m_currentPage) break;
+      if (++it == pageList.end()) {
+        --it;
+        break;
+      }
+    }
+    m_ds->m_pageSpan.m_pageSpan=it->m_pageSpan;
+    m_ps->m_numPagesRemainingInSpan=std::max(0, it->m_pageSpan-1-numSentPages);
+  }
+  m_ds->m_pageList=pageList;
+}
+
 void STOFFTextListener::setDocumentMetaData(librevenge::RVNGPropertyList const &meta)
 {
   librevenge::RVNGPropertyList::Iter i(meta);
@@ -1005,14 +1079,29 @@ void STOFFTextListener::_openSpan()
       _openListElement();
   }
 
-  librevenge::RVNGPropertyList propList;
-  m_ps->m_font.addTo(propList);
-  STOFFFont::checkForDefault(propList);
-  m_documentInterface->openSpan(propList);
+  if (!m_ps->m_spanStyle)
+    m_ps->m_spanStyle=_getSpanStyle(m_ps->m_font, m_ps->m_font.hash());
+  m_documentInterface->openSpan(m_ps->m_spanStyle->m_propertyList);
 
   m_ps->m_isSpanOpened = true;
 }
 
+std::shared_ptr<STOFFTextListenerInternal::SpanStyle> STOFFTextListener::_getSpanStyle(STOFFFont const &font, size_t hash)
+{
+  auto &cache=m_ds->m_spanStyleCache;
+  auto range=cache.equal_range(hash);
+  for (auto it=range.first; it!=range.second; ++it) {
+    if (it->second && it->second->m_font==font)
+      return it->second;
+  }
+  // a document uses generally few fonts, but let us bound the cache size
+  if (cache.size()>=1000)
+    cache.clear();
+  std::shared_ptr<STOFFTextListenerInternal::SpanStyle> style(new STOFFTextListenerInternal::SpanStyle(font, hash));
+  cache.insert(std::make_pair(hash, style));
+  return style;
+}
+
 void STOFFTextListener::_closeSpan()
 {
   // better not to close a link...
@@ -1237,6 +1326,7 @@ void STOFFTextListener::insertShape(STOFFGraphicShape const &shape, STOFFGraphic
 
 void STOFFTextListener::insertPicture(STOFFPosition const &pos, STOFFEmbeddedObject const &picture, STOFFGraphicStyle const &style)
 {
+  if (m_skipPictures) return;
   if (!openFrame(pos, style)) return;
 
   librevenge::RVNGPropertyList propList;
@@ -48,6 +48,7 @@ class STOFFTextShape;
 
 namespace STOFFTextListenerInternal
 {
+struct SpanStyle;
 struct TextState;
 struct State;
 }
@@ -74,6 +75,10 @@ public:
   void setDocumentLanguage(std::string locale) final;
   /** sets the document meta data */
   void setDocumentMetaData(const librevenge::RVNGPropertyList &list) final;
+  /** updates the list of page spans: used when the document is sent before being totally read.
+
+      \note the spans which are already sent are not modified, only the number of pages of the current span can be changed */
+  void setPageSpans(std::vector<STOFFPageSpan> const &pageList);
   /** starts a new document */
   void startDocument() final;
   /** ends the actual document */
@@ -144,6 +149,8 @@ public:
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   void insertUnicode(uint32_t character) final;
+  /** adds a run of unicode characters (without tab and end of line) */
+  void insertUnicodeRun(uint32_t const *characters, size_t num) final;
   //! adds a unicode string
   void insertUnicodeString(librevenge::RVNGString const &str) final;
 
@@ -278,6 +285,8 @@ protected:
 
   /** low level: the function which opens a new span property */
   void _openSpan();
+  /** low level: returns the span style corresponding to a font (and its hash value), creates it if needed */
+  std::shared_ptr<STOFFTextListenerInternal::SpanStyle> _getSpanStyle(STOFFFont const &font, size_t hash);
   /** low level: the function which closes the last opened span property */
   void _closeSpan();
 
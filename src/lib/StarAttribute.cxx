@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <array>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -83,17 +84,42 @@ StarAttributeXML::~StarAttributeXML()
 {
 }
 ////////////////////////////////////////
-//! Internal: the state of a StarAttribute
+/** Internal: the state of a StarAttribute: the prototype of each attribute
+
+    \note this state is created once and shared by all the managers, so it must not be modified after its creation
+ */
 struct State {
   //! constructor
-  State() : m_whichToAttributeMap()
+  State() : m_whichToAttributeMap(), m_whichToAttributeList()
   {
     initAttributeMap();
+    for (auto const &it : m_whichToAttributeMap) {
+      if (it.first<0 || it.first>=int(m_whichToAttributeList.size())) {
+        STOFF_DEBUG_MSG(("StarAttributeInternal::State: find unexpected attribute %d\n", it.first));
+        continue;
+      }
+      m_whichToAttributeList[size_t(it.first)]=it.second;
+    }
+    m_whichToAttributeMap.clear();
+  }
+  //! returns the prototype corresponding to an attribute if it exists
+  StarAttribute const *get(int which) const
+  {
+    if (which<0 || which>=int(m_whichToAttributeList.size())) return nullptr;
+    return m_whichToAttributeList[size_t(which)].get();
+  }
+  //! returns the shared state
+  static std::shared_ptr<State const> getSharedState()
+  {
+    static std::shared_ptr<State const> const state(new State);
+    return state;
   }
   //! init the attribute map list
   void initAttributeMap();
-  //! a map which to an attribute
+  //! a map which to an attribute (only used to create the list)
   std::map<int, std::shared_ptr<StarAttribute> > m_whichToAttributeMap;
+  //! the list of attributes prototypes indexed by which
+  std::array<std::shared_ptr<StarAttribute const>, size_t(StarAttribute::SDRATTR_3DSCENE_RESERVED_20)+1> m_whichToAttributeList;
 protected:
   //! add a void attribute
   void addAttributeVoid(StarAttribute::Type type, std::string const &debugName)
@@ -556,7 +582,7 @@ bool StarAttributeItemSet::send(STOFFListenerPtr listener, StarState &state, std
 ////////////////////////////////////////////////////////////
 
 StarAttributeManager::StarAttributeManager()
-  : m_state(new StarAttributeInternal::State)
+  : m_state(StarAttributeInternal::State::getSharedState())
 {
 }
 
@@ -575,9 +601,9 @@ std::shared_ptr<StarAttribute> StarAttributeManager::getDummyAttribute(int id)
 
 std::shared_ptr<StarAttribute> StarAttributeManager::getDefaultAttribute(int nWhich)
 {
-  if (m_state->m_whichToAttributeMap.find(nWhich)!=m_state->m_whichToAttributeMap.end() &&
-      m_state->m_whichToAttributeMap.find(nWhich)->second)
-    return m_state->m_whichToAttributeMap.find(nWhich)->second->create();
+  auto const *proto=m_state->get(nWhich);
+  if (proto)
+    return proto->create();
   return getDummyAttribute();
 }
 
@@ -589,9 +615,9 @@ std::shared_ptr<StarAttribute> StarAttributeManager::readAttribute(StarZone &zon
   f << "Entries(StarAttribute)[" << zone.getRecordLevel() << "]:";
 
   long pos=input->tell();
-  if (m_state->m_whichToAttributeMap.find(nWhich)!=m_state->m_whichToAttributeMap.end() &&
-      m_state->m_whichToAttributeMap.find(nWhich)->second) {
-    auto attrib=m_state->m_whichToAttributeMap.find(nWhich)->second->create();
+  auto const *proto=m_state->get(nWhich);
+  if (proto) {
+    auto attrib=proto->create();
     if (!attrib || !attrib->read(zone, nVers, lastPos, object)) {
       STOFF_DEBUG_MSG(("StarAttributeManager::readAttribute: can not read an attribute\n"));
       f << "###bad";
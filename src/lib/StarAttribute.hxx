@@ -1098,8 +1098,8 @@ protected:
   // data
   //
 private:
-  //! the state
-  std::shared_ptr<StarAttributeInternal::State> m_state;
+  //! the state: the attribute prototypes shared by all the managers
+  std::shared_ptr<StarAttributeInternal::State const> m_state;
 };
 #endif
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
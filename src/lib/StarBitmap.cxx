@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -220,25 +221,10 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
   // bitmap2.cxx: Bitmap::Read
   long dataPos=0, offset=0;
   if (inFileHeader) {
-    // ImplReadDIBFileHeader
     f << "header,";
-    uint16_t header;
-    *input >> header;
-    bool ok=true;
-    if (header==0x4142) {
-      input->seek(12, librevenge::RVNG_SEEK_CUR);
-      ok=(input->readULong(2)==0x4d42);
-      input->seek(8, librevenge::RVNG_SEEK_CUR);
-      offset=long(input->readULong(4));
-    }
-    else if (header==0x4d42) {
-      input->seek(8, librevenge::RVNG_SEEK_CUR);
-      offset=long(input->readULong(4));
-    }
-    else
-      ok=false;
+    bool ok=readFileHeader(input, offset);
     f << "offset=" << offset << ",";
-    if (!ok || offset<0) {
+    if (!ok) {
       STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not read the header\n"));
       f << "###";
       ascFile.addPos(pos);
@@ -313,6 +299,7 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
     strm.next_in = reinterpret_cast<Bytef *>(const_cast<uint8_t *>(data));
 
     std::vector<unsigned char> converted;
+    libstoff::ParseGuard::checkAllocation(static_cast<unsigned long>(uncodeSize), 1);
     converted.resize(size_t(uncodeSize),0);
 
     strm.avail_out = uncodeSize;
@@ -409,7 +396,7 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
     else {
       type="image/bm";
 #if defined(DEBUG_WITH_FILES) && DEBUG_WITH_FILES
-      static int bitmapNum=0;
+      static std::atomic<int> bitmapNum(0);
       std::stringstream s;
       s << "Bitmap" << ++bitmapNum << ".bm";
       libstoff::Debug::dumpFile(result, s.str().c_str());
@@ -427,7 +414,7 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
 #ifdef DEBUG_WITH_FILES
   if (1) {
     librevenge::RVNGBinaryData data;
-    static int bitmapNum=0;
+    static std::atomic<int> bitmapNum(0);
     std::stringstream s;
     s << "Bitmap" << ++bitmapNum << ".ppm";
 
@@ -442,6 +429,70 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
   return true;
 }
 
+bool StarBitmap::readFileHeader(STOFFInputStreamPtr &input, long &offset)
+{
+  // ImplReadDIBFileHeader
+  offset=0;
+  if (!input->checkPosition(input->tell()+14))
+    return false;
+  uint16_t header;
+  *input >> header;
+  bool ok=true;
+  if (header==0x4142) {
+    input->seek(12, librevenge::RVNG_SEEK_CUR);
+    ok=(input->readULong(2)==0x4d42);
+    input->seek(8, librevenge::RVNG_SEEK_CUR);
+    offset=long(input->readULong(4));
+  }
+  else if (header==0x4d42) {
+    input->seek(8, librevenge::RVNG_SEEK_CUR);
+    offset=long(input->readULong(4));
+  }
+  else
+    ok=false;
+  return ok && offset>=0;
+}
+
+bool StarBitmap::readBitmapHeaders(StarZone &zone, long lastPos, long &endPos)
+{
+  endPos=0;
+  STOFFInputStreamPtr input=zone.input();
+  long beginPos=input->tell(), offset=0;
+  if (!readFileHeader(input, offset)) {
+    STOFF_DEBUG_MSG(("StarBitmap::readBitmapHeaders: can not read the header\n"));
+    return false;
+  }
+  auto &bitmap=m_state->m_bitmap;
+  if (!readBitmapInformation(zone, bitmap, lastPos) || !bitmap.m_width || !bitmap.m_height)
+    return false;
+  if (bitmap.m_compression==0x1004453) {
+    if (!input->checkPosition(input->tell()+12))
+      return false;
+    uint32_t codeSize, uncodeSize, compression;
+    *input>>codeSize>>uncodeSize>>compression;
+    if (input->tell()+long(codeSize)>lastPos)
+      return false;
+    endPos=input->tell()+long(codeSize);
+    return true;
+  }
+  // only compute the end of the data when its beginning is known
+  if (!offset || beginPos+offset>lastPos)
+    return true;
+  long dataPos=beginPos+offset;
+  if ((bitmap.m_bitCount==8 && bitmap.m_compression==1) || (bitmap.m_bitCount==4 && bitmap.m_compression==2)) { // bRLE
+    if (bitmap.m_sizeImage && long(bitmap.m_sizeImage)<=lastPos-dataPos)
+      endPos=dataPos+long(bitmap.m_sizeImage);
+    return true;
+  }
+  uint32_t alignWidth=bitmap.m_width*bitmap.m_bitCount;
+  if (alignWidth/bitmap.m_width!=bitmap.m_bitCount)
+    return true;
+  alignWidth=(((alignWidth+31)>>5)<<2);
+  if (alignWidth && uint32_t(lastPos-dataPos)/alignWidth>=bitmap.m_height)
+    endPos=dataPos+long(bitmap.m_height*alignWidth);
+  return true;
+}
+
 bool StarBitmap::readBitmapInformation(StarZone &zone, StarBitmapInternal::Bitmap &info, long lastPos)
 {
   // bitmap2.cxx ImplReadDIBInfoHeader
@@ -545,6 +596,7 @@ bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::
     if (bitmap.m_sizeImage) lastPos= input->tell() + long(bitmap.m_sizeImage);
     bool bit4=bitmap.m_compression==2;
     size_t wPos=0, lastWPos=size_t(bitmap.m_height*bitmap.m_width);
+    libstoff::ParseGuard::checkAllocation(static_cast<unsigned long>(lastWPos), sizeof(int));
     bitmap.m_indexDataList.resize(size_t(lastWPos),0);
     uint32_t x=0, y=0;
     while (true) {
@@ -629,6 +681,8 @@ bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::
     STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: the zone seems too short\n"));
     return false;
   }
+  libstoff::ParseGuard::checkAllocation(static_cast<unsigned long>(bitmap.m_height)*bitmap.m_width,
+                                        bitmap.m_bitCount<=8 ? sizeof(int) : sizeof(STOFFColor));
   switch (bitmap.m_bitCount) {
   case 1: {
     bitmap.m_indexDataList.resize(size_t(bitmap.m_height*bitmap.m_width));
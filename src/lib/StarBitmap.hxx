@@ -75,11 +75,17 @@ public:
 
    \note only fill data and type if the bitmap has a file header*/
   bool readBitmap(StarZone &zone, bool inFileHeader, long lastPos, librevenge::RVNGBinaryData &data, std::string &type);
+  /** try to read only the headers of a bitmap with a file header: the pixels are not decoded.
+
+   \note endPos is set to the end of the bitmap data if it can be computed, 0 otherwise*/
+  bool readBitmapHeaders(StarZone &zone, long lastPos, long &endPos);
   //! try to convert the read data in ppm
   bool getData(librevenge::RVNGBinaryData &data, std::string &type) const;
   //! try to return the bitmap size (in point)
   STOFFVec2i getBitmapSize() const;
 protected:
+  //! try to read the bitmap file header, returns the data offset
+  static bool readFileHeader(STOFFInputStreamPtr &input, long &offset);
   //! try to read the bitmap information block
   bool readBitmapInformation(StarZone &zone, StarBitmapInternal::Bitmap &info, long lastPos);
   //! try to read the bitmap data block
@@ -164,67 +164,67 @@ StarCAttributeVoid::~StarCAttributeVoid()
 void StarCAttributeBool::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_SC_LINEBREAK)
-    state.m_cell.m_propertyList.insert("fo:wrap-option",m_value ? "wrap" : "no-wrap");
+    state.m_cell.edit().m_propertyList.insert("fo:wrap-option",m_value ? "wrap" : "no-wrap");
 }
 
 void StarCAttributeInt::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_SC_ROTATE_VALUE)
-    state.m_cell.m_propertyList.insert("style:rotation-angle",m_value/100);
+    state.m_cell.edit().m_propertyList.insert("style:rotation-angle",m_value/100);
 }
 
 void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_SC_VALUE_FORMAT)
-    state.m_cell.m_format=unsigned(m_value);
+    state.m_cell.edit().m_format=unsigned(m_value);
   else if (m_type==ATTR_SC_HORJUSTIFY) {
-    state.m_cell.m_propertyList.insert("style:repeat-content", false);
+    state.m_cell.edit().m_propertyList.insert("style:repeat-content", false);
     switch (m_value) {
     case 0: // standard
-      state.m_cell.m_propertyList.insert("style:text-align-source", "value-type");
-      if (state.m_cell.m_propertyList["fo:text-align"]) state.m_cell.m_propertyList.remove("fo:text-align");
+      state.m_cell.edit().m_propertyList.insert("style:text-align-source", "value-type");
+      if (state.m_cell.edit().m_propertyList["fo:text-align"]) state.m_cell.edit().m_propertyList.remove("fo:text-align");
       break;
     case 1: // left
     case 2: // center
     case 3: // right
-      state.m_cell.m_propertyList.insert("style:text-align-source", "fix");
-      state.m_cell.m_propertyList.insert("fo:text-align", m_value==1 ? "start" : m_value==2 ? "center" : "end");
+      state.m_cell.edit().m_propertyList.insert("style:text-align-source", "fix");
+      state.m_cell.edit().m_propertyList.insert("fo:text-align", m_value==1 ? "start" : m_value==2 ? "center" : "end");
       break;
     case 4: // block
-      state.m_cell.m_propertyList.insert("style:text-align-source", "fix");
-      state.m_cell.m_propertyList.insert("fo:text-align", "justify");
+      state.m_cell.edit().m_propertyList.insert("style:text-align-source", "fix");
+      state.m_cell.edit().m_propertyList.insert("fo:text-align", "justify");
       break;
     case 5: // repeat
-      state.m_cell.m_propertyList.insert("style:repeat-content", true);
+      state.m_cell.edit().m_propertyList.insert("style:repeat-content", true);
       break;
     default:
-      state.m_cell.m_propertyList.insert("style:text-align-source", "value-type");
-      if (state.m_cell.m_propertyList["fo:text-align"]) state.m_cell.m_propertyList.remove("fo:text-align");
+      state.m_cell.edit().m_propertyList.insert("style:text-align-source", "value-type");
+      if (state.m_cell.edit().m_propertyList["fo:text-align"]) state.m_cell.edit().m_propertyList.remove("fo:text-align");
       STOFF_DEBUG_MSG(("StarCellAttribute::StarCAttributeUInt::addTo: find unknown horizontal enum=%d\n", int(m_value)));
       break;
     }
   }
   else if (m_type==ATTR_SC_INDENT)
-    state.m_cell.m_propertyList.insert("fo:margin-left", double(m_value)/18.3, librevenge::RVNG_POINT);
+    state.m_cell.edit().m_propertyList.insert("fo:margin-left", double(m_value)/18.3, librevenge::RVNG_POINT);
   else if (m_type==ATTR_SC_VERJUSTIFY || m_type==ATTR_SC_ROTATE_MODE) {
     switch (m_value) {
     case 0: // standard
       if (m_type==ATTR_SC_VERJUSTIFY)
-        state.m_cell.m_propertyList.insert("style:vertical-align", "automatic");
+        state.m_cell.edit().m_propertyList.insert("style:vertical-align", "automatic");
       else
-        state.m_cell.m_propertyList.insert("style:rotation-align", "none");
+        state.m_cell.edit().m_propertyList.insert("style:rotation-align", "none");
       break;
     case 1: // top
     case 2: // center
     case 3: // bottom
-      state.m_cell.m_propertyList.insert(m_type==ATTR_SC_VERJUSTIFY ? "style:vertical-align" : "style:rotation-align",
+      state.m_cell.edit().m_propertyList.insert(m_type==ATTR_SC_VERJUSTIFY ? "style:vertical-align" : "style:rotation-align",
                                          m_value==1 ? "top" : m_value==2 ? "middle" : "bottom");
       break;
     default:
       if (m_type==ATTR_SC_VERJUSTIFY)
-        state.m_cell.m_propertyList.insert("style:vertical-align", "automatic");
+        state.m_cell.edit().m_propertyList.insert("style:vertical-align", "automatic");
       else
-        state.m_cell.m_propertyList.insert("style:rotation-align", "none");
+        state.m_cell.edit().m_propertyList.insert("style:rotation-align", "none");
       if (m_type==ATTR_SC_VERJUSTIFY && m_value==4) // block ?
         break;
       STOFF_DEBUG_MSG(("StarCellAttribute::StarCAttributeUInt::addTo: find unknown vertical/rotateMode enum=%d\n", int(m_value)));
@@ -232,19 +232,19 @@ void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
     }
   }
   else if (m_type==ATTR_SC_ORIENTATION) {
-    if (state.m_cell.m_propertyList["style:direction"]) state.m_cell.m_propertyList.remove("style:direction");
+    if (state.m_cell.edit().m_propertyList["style:direction"]) state.m_cell.edit().m_propertyList.remove("style:direction");
     // fixme: we must also revert the rotation angle, but ...
     switch (m_value) {
     case 0: // standard
       break;
     case 1: // topbottom
     case 2: { // bottomtop
-      int prevRot=state.m_cell.m_propertyList["style:rotation-angle"] ? state.m_cell.m_propertyList["style:rotation-angle"]->getInt() : 0;
-      state.m_cell.m_propertyList.insert("style:rotation-angle",prevRot+(m_value==1 ? 270 : 90));
+      int prevRot=state.m_cell->m_propertyList["style:rotation-angle"] ? state.m_cell->m_propertyList["style:rotation-angle"]->getInt() : 0;
+      state.m_cell.edit().m_propertyList.insert("style:rotation-angle",prevRot+(m_value==1 ? 270 : 90));
       break;
     }
     case 3: // stacked
-      state.m_cell.m_propertyList.insert("style:direction","ttb");
+      state.m_cell.edit().m_propertyList.insert("style:direction","ttb");
       break;
     default:
       STOFF_DEBUG_MSG(("StarCellAttribute::StarCAttributeUInt::addTo: find unknown orientation enum=%d\n", int(m_value)));
@@ -254,10 +254,10 @@ void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   else if (m_type==ATTR_SC_WRITINGDIR) {
     if (m_value<=4) {
       char const *(wh[])= {"lr-tb", "rl-tb", "tb-rl", "tb-lr", "page"};
-      state.m_cell.m_propertyList.insert("style:writing-mode", wh[m_value]);
+      state.m_cell.edit().m_propertyList.insert("style:writing-mode", wh[m_value]);
     }
     else {
-      state.m_cell.m_propertyList.insert("style:writing-mode", "page");
+      state.m_cell.edit().m_propertyList.insert("style:writing-mode", "page");
       STOFF_DEBUG_MSG(("StarCellAttribute::StarCAttributeUInt::addTo: find unknown writing dir enum=%d\n", int(m_value)));
     }
   }
@@ -484,7 +484,7 @@ void StarCAttributeMargins::addTo(StarState &state, std::set<StarAttribute const
     return;
   for (int i=0; i<4; ++i) {
     char const *(wh[])= {"top", "left", "right", "bottom"};
-    state.m_cell.m_propertyList.insert((std::string("fo:padding-")+wh[i]).c_str(), double(m_margins[i])/20., librevenge::RVNG_POINT);
+    state.m_cell.edit().m_propertyList.insert((std::string("fo:padding-")+wh[i]).c_str(), double(m_margins[i])/20., librevenge::RVNG_POINT);
   }
 }
 
@@ -492,14 +492,14 @@ void StarCAttributeMerge::addTo(StarState &state, std::set<StarAttribute const *
 {
   if (m_type!=ATTR_SC_MERGE)
     return;
-  state.m_cell.m_numberCellSpanned=STOFFVec2i(1,1);
+  state.m_cell.edit().m_numberCellSpanned=STOFFVec2i(1,1);
   if (m_span==STOFFVec2i(0,0)) // checkme
     return;
   if (m_span[0]<=0 || m_span[1]<=0) {
     STOFF_DEBUG_MSG(("StarCellAttribute::StarCAttributeMerge::addTo: the span value %dx%d seems bad\n", m_span[0], m_span[1]));
   }
   else
-    state.m_cell.m_numberCellSpanned=m_span;
+    state.m_cell.edit().m_numberCellSpanned=m_span;
 }
 
 void StarCAttributeProtection::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
@@ -507,13 +507,13 @@ void StarCAttributeProtection::addTo(StarState &state, std::set<StarAttribute co
   if (m_type!=ATTR_SC_PROTECTION)
     return;
   if (m_hiddenCell)
-    state.m_cell.m_propertyList.insert("style:cell-protect","hidden-and-protected");
+    state.m_cell.edit().m_propertyList.insert("style:cell-protect","hidden-and-protected");
   else if (m_protected || m_hiddenFormula)
-    state.m_cell.m_propertyList.insert
+    state.m_cell.edit().m_propertyList.insert
     ("style:cell-protect", m_protected ? (m_hiddenFormula ? "hidden-and-protected" : "protected") : "formula-hidden");
   else
-    state.m_cell.m_propertyList.insert("style:cell-protect","none");
-  state.m_cell.m_propertyList.insert("style:print-content", m_doNotPrint);
+    state.m_cell.edit().m_propertyList.insert("style:cell-protect","none");
+  state.m_cell.edit().m_propertyList.insert("style:print-content", m_doNotPrint);
   // hiddenCell ?
 }
 
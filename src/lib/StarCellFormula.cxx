@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -371,10 +372,9 @@ void StarCellFormula::updateFormula(STOFFCellContent &content, std::vector<libre
         form.m_sheetId<0 || form.m_sheetId==sheetId)
       continue;
     if (form.m_sheetId>=numNames) {
-      static bool first=true;
-      if (first) {
+      static std::atomic<bool> first(true);
+      if (first.exchange(false)) {
         STOFF_DEBUG_MSG(("StarCellFormula::updateFormula: some sheetId are bad\n"));
-        first=false;
       }
       continue;
     }
@@ -516,10 +516,10 @@ bool StarCellFormula::readSCFormula(StarZone &zone, STOFFCellContent &content, i
 #endif
   }
   if (!formulaSet) {
-    static bool first=true;
-    if (first) {
+    // can be called by the threads which read the spreadsheet tables
+    static std::atomic<bool> first(true);
+    if (first.exchange(false)) {
       STOFF_DEBUG_MSG(("StarCellFormula::readSCFormula: can not reconstruct some formula\n"));
-      first=false;
     }
     f << "###";
   }
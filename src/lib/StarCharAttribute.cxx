@@ -182,35 +182,35 @@ inline void addAttributeVoid(std::map<int, std::shared_ptr<StarAttribute> > &map
 void StarCAttributeBool::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_CHR_CONTOUR)
-    state.m_font.m_propertyList.insert("style:text-outline", m_value);
+    state.m_font.edit().m_propertyList.insert("style:text-outline", m_value);
   else if (m_type==ATTR_CHR_SHADOWED)
-    state.m_font.m_propertyList.insert("fo:text-shadow", m_value ? "1pt 1pt" : "none");
+    state.m_font.edit().m_propertyList.insert("fo:text-shadow", m_value ? "1pt 1pt" : "none");
   else if (m_type==ATTR_CHR_BLINK)
-    state.m_font.m_propertyList.insert("style:text-blinking", m_value);
+    state.m_font.edit().m_propertyList.insert("style:text-blinking", m_value);
   else if (m_type==ATTR_CHR_WORDLINEMODE)  {
-    state.m_font.m_propertyList.insert("style:text-line-through-mode", m_value ? "skip-white-space" : "continuous");
-    state.m_font.m_propertyList.insert("style:text-underline-mode", m_value ? "skip-white-space" : "continuous");
+    state.m_font.edit().m_propertyList.insert("style:text-line-through-mode", m_value ? "skip-white-space" : "continuous");
+    state.m_font.edit().m_propertyList.insert("style:text-underline-mode", m_value ? "skip-white-space" : "continuous");
   }
   else if (m_type==ATTR_CHR_AUTOKERN)
-    state.m_font.m_propertyList.insert("style:letter-kerning", m_value);
+    state.m_font.edit().m_propertyList.insert("style:letter-kerning", m_value);
   else if (m_type==ATTR_SC_HYPHENATE)
-    state.m_font.m_propertyList.insert("fo:hyphenate", m_value);
+    state.m_font.edit().m_propertyList.insert("fo:hyphenate", m_value);
   else if (m_type==ATTR_CHR_NOHYPHEN)
-    state.m_font.m_hyphen=!m_value;
+    state.m_font.edit().m_hyphen=!m_value;
   else if (m_type==ATTR_CHR_NOLINEBREAK)
-    state.m_font.m_lineBreak=!m_value;
+    state.m_font.edit().m_lineBreak=!m_value;
 }
 
 void StarCAttributeColor::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_CHR_COLOR)
-    state.m_font.m_propertyList.insert("fo:color", m_value.str().c_str());
+    state.m_font.edit().m_propertyList.insert("fo:color", m_value.str().c_str());
 }
 
 void StarCAttributeInt::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_CHR_KERNING)
-    state.m_font.m_propertyList.insert("fo:letter-spacing", m_value, librevenge::RVNG_TWIP);
+    state.m_font.edit().m_propertyList.insert("fo:letter-spacing", m_value, librevenge::RVNG_TWIP);
 }
 
 void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
@@ -218,28 +218,28 @@ void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   if (m_type==ATTR_CHR_CROSSEDOUT) {
     switch (m_value) {
     case 0: // none
-      state.m_font.m_propertyList.insert("style:text-line-through-type", "none");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-type", "none");
       break;
     case 1: // single
     case 2: // double
-      state.m_font.m_propertyList.insert("style:text-line-through-type", m_value==1 ? "single" : "double");
-      state.m_font.m_propertyList.insert("style:text-line-through-style", "solid");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-type", m_value==1 ? "single" : "double");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-style", "solid");
       break;
     case 3: // dontknow
       break;
     case 4: // bold
-      state.m_font.m_propertyList.insert("style:text-line-through-type", "single");
-      state.m_font.m_propertyList.insert("style:text-line-through-style", "solid");
-      state.m_font.m_propertyList.insert("style:text-line-through-width", "thick");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-type", "single");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-style", "solid");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-width", "thick");
       break;
     case 5: // slash
     case 6: // X
-      state.m_font.m_propertyList.insert("style:text-line-through-type", "single");
-      state.m_font.m_propertyList.insert("style:text-line-through-style", "solid");
-      state.m_font.m_propertyList.insert("style:text-line-through-text", m_value==5 ? "/" : "X");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-type", "single");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-style", "solid");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-text", m_value==5 ? "/" : "X");
       break;
     default:
-      state.m_font.m_propertyList.insert("style:text-line-through-type", "none");
+      state.m_font.edit().m_propertyList.insert("style:text-line-through-type", "none");
       STOFF_DEBUG_MSG(("StarCharAttribute::StarCAttributeUInt: find unknown crossedout enum=%d\n", m_value));
       break;
     }
@@ -248,29 +248,29 @@ void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
     switch (m_value) {
     case 0: // none
     case 4: // unknown
-      state.m_font.m_propertyList.insert("style:text-underline-type", "none");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-type", "none");
       break;
     case 1: // single
     case 2: // double
-      state.m_font.m_propertyList.insert("style:text-underline-type", m_value==1 ? "single" : "double");
-      state.m_font.m_propertyList.insert("style:text-underline-style", "solid");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-type", m_value==1 ? "single" : "double");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-style", "solid");
       break;
     case 3: // dot
     case 5: // dash
     case 6: // long-dash
     case 7: // dash-dot
     case 8: // dash-dot-dot
-      state.m_font.m_propertyList.insert("style:text-underline-type", "single");
-      state.m_font.m_propertyList.insert("style:text-underline-style", m_value==3 ? "dotted" : m_value==5 ? "dash" :
+      state.m_font.edit().m_propertyList.insert("style:text-underline-type", "single");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-style", m_value==3 ? "dotted" : m_value==5 ? "dash" :
                                          m_value==6 ? "long-dash" : m_value==7 ? "dot-dash" : "dot-dot-dash");
       break;
     case 9: // small wave
     case 10: // wave
     case 11: // double wave
-      state.m_font.m_propertyList.insert("style:text-underline-type", m_value==11 ? "single" : "double");
-      state.m_font.m_propertyList.insert("style:text-underline-style", "wave");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-type", m_value==11 ? "single" : "double");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-style", "wave");
       if (m_value==9)
-        state.m_font.m_propertyList.insert("style:text-underline-width", "thin");
+        state.m_font.edit().m_propertyList.insert("style:text-underline-width", "thin");
       break;
     case 12: // bold
     case 13: // bold dot
@@ -280,13 +280,13 @@ void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
     case 17: // bold dash-dot-dot
     case 18: { // bold wave
       char const *(wh[])= {"solid", "dotted", "dash", "long-dash", "dot-dash", "dot-dot-dash", "wave"};
-      state.m_font.m_propertyList.insert("style:text-underline-type", "single");
-      state.m_font.m_propertyList.insert("style:text-underline-style", wh[m_value-12]);
-      state.m_font.m_propertyList.insert("style:text-underline-width", "thick");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-type", "single");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-style", wh[m_value-12]);
+      state.m_font.edit().m_propertyList.insert("style:text-underline-width", "thick");
       break;
     }
     default:
-      state.m_font.m_propertyList.insert("style:text-underline-type", "none");
+      state.m_font.edit().m_propertyList.insert("style:text-underline-type", "none");
       STOFF_DEBUG_MSG(("StarCharAttribute::StarCAttributeUInt: find unknown underline enum=%d\n", m_value));
       break;
     }
@@ -294,49 +294,49 @@ void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   else if (m_type==ATTR_CHR_POSTURE || m_type==ATTR_CHR_CJK_POSTURE || m_type==ATTR_CHR_CTL_POSTURE) {
     std::string wh(m_type==ATTR_CHR_POSTURE ? "fo:font-style" :  m_type==ATTR_CHR_CJK_POSTURE ? "style:font-style-asian" : "style:font-style-complex");
     if (m_value==1)
-      state.m_font.m_propertyList.insert(wh.c_str(), "oblique");
+      state.m_font.edit().m_propertyList.insert(wh.c_str(), "oblique");
     else if (m_value==2)
-      state.m_font.m_propertyList.insert(wh.c_str(), "italic");
+      state.m_font.edit().m_propertyList.insert(wh.c_str(), "italic");
     else if (m_value) {
       STOFF_DEBUG_MSG(("StarCharAttribute::StarCAttributeUInt: find unknown posture enum=%d\n", m_value));
     }
   }
   else if (m_type==ATTR_CHR_RELIEF) {
     if (m_value==0)
-      state.m_font.m_propertyList.insert("style:font-relief", "none");
+      state.m_font.edit().m_propertyList.insert("style:font-relief", "none");
     else if (m_value==1)
-      state.m_font.m_propertyList.insert("style:font-relief", "embossed");
+      state.m_font.edit().m_propertyList.insert("style:font-relief", "embossed");
     else if (m_value==2)
-      state.m_font.m_propertyList.insert("style:font-relief", "engraved");
+      state.m_font.edit().m_propertyList.insert("style:font-relief", "engraved");
     else if (m_value) {
-      state.m_font.m_propertyList.insert("style:font-relief", "none");
+      state.m_font.edit().m_propertyList.insert("style:font-relief", "none");
       STOFF_DEBUG_MSG(("StarCharAttribute::StarCAttributeUInt: find unknown relief enum=%d\n", m_value));
     }
   }
   else if (m_type==ATTR_CHR_WEIGHT || m_type==ATTR_CHR_CJK_WEIGHT || m_type==ATTR_CHR_CTL_WEIGHT) {
     std::string wh(m_type==ATTR_CHR_WEIGHT ? "fo:font-weight" :  m_type==ATTR_CHR_CJK_WEIGHT ? "style:font-weight-asian" : "style:font-weight-complex");
     if (m_value==5)
-      state.m_font.m_propertyList.insert(wh.c_str(), "normal");
+      state.m_font.edit().m_propertyList.insert(wh.c_str(), "normal");
     else if (m_value==8)
-      state.m_font.m_propertyList.insert(wh.c_str(), "bold");
+      state.m_font.edit().m_propertyList.insert(wh.c_str(), "bold");
     else if (m_value>=1 && m_value<=9)
-      state.m_font.m_propertyList.insert(wh.c_str(), m_value*100, librevenge::RVNG_GENERIC);
+      state.m_font.edit().m_propertyList.insert(wh.c_str(), m_value*100, librevenge::RVNG_GENERIC);
     else // 10: WEIGHT_BLACK
-      state.m_font.m_propertyList.insert(wh.c_str(), "normal");
+      state.m_font.edit().m_propertyList.insert(wh.c_str(), "normal");
   }
   else if (m_type==ATTR_CHR_CASEMAP) {
     if (m_value==0)
-      state.m_font.m_propertyList.insert("fo:text-transform", "none");
+      state.m_font.edit().m_propertyList.insert("fo:text-transform", "none");
     else if (m_value==1)
-      state.m_font.m_propertyList.insert("fo:text-transform", "uppercase");
+      state.m_font.edit().m_propertyList.insert("fo:text-transform", "uppercase");
     else if (m_value==2)
-      state.m_font.m_propertyList.insert("fo:text-transform", "lowercase");
+      state.m_font.edit().m_propertyList.insert("fo:text-transform", "lowercase");
     else if (m_value==3)
-      state.m_font.m_propertyList.insert("fo:text-transform", "capitalize");
+      state.m_font.edit().m_propertyList.insert("fo:text-transform", "capitalize");
     else if (m_value==4)
-      state.m_font.m_propertyList.insert("fo:font-variant", "small-caps");
+      state.m_font.edit().m_propertyList.insert("fo:font-variant", "small-caps");
     else if (m_value) {
-      state.m_font.m_propertyList.insert("fo:text-transform", "none");
+      state.m_font.edit().m_propertyList.insert("fo:text-transform", "none");
       STOFF_DEBUG_MSG(("StarCharAttribute::StarCAttributeUInt: find unknown casemap enum=%d\n", m_value));
     }
   }
@@ -347,31 +347,31 @@ void StarCAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
     std::string lang, country;
     if (StarLanguage::getLanguageId(int(m_value), lang, country)) {
       if (!lang.empty())
-        state.m_font.m_propertyList.insert((prefix + "language" + extension).c_str(), lang.c_str());
+        state.m_font.edit().m_propertyList.insert((prefix + "language" + extension).c_str(), lang.c_str());
       if (!country.empty())
-        state.m_font.m_propertyList.insert((prefix + "country" + extension).c_str(), country.c_str());
+        state.m_font.edit().m_propertyList.insert((prefix + "country" + extension).c_str(), country.c_str());
     }
   }
   else if (m_type==ATTR_CHR_PROPORTIONALFONTSIZE && m_value!=100) // checkme: maybe font-size with %
-    state.m_font.m_propertyList.insert("style:text-scale", double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_font.edit().m_propertyList.insert("style:text-scale", double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==ATTR_CHR_EMPHASIS_MARK) {
     if (m_value && ((m_value&0xC000)==0 || (m_value&0x3000)==0x3000 || (m_value&0xFFF)>4 || (m_value&0xFFF)==0)) {
-      state.m_font.m_propertyList.insert("style:text-emphasize", "none");
+      state.m_font.edit().m_propertyList.insert("style:text-emphasize", "none");
       STOFF_DEBUG_MSG(("StarCharAttribute::StarCAttributeUInt: find unknown emphasis mark=%x\n", unsigned(m_value)));
     }
     else if (m_value) {
       std::string what((m_value&7)== 1 ? "dot" : (m_value&7)== 2 ? "circle" : (m_value&7)== 3 ? "disc" : "accent");
-      state.m_font.m_propertyList.insert("style:text-emphasize", (what+((m_value&0x1000) ? " above" : " below")).c_str());
+      state.m_font.edit().m_propertyList.insert("style:text-emphasize", (what+((m_value&0x1000) ? " above" : " below")).c_str());
     }
     else
-      state.m_font.m_propertyList.insert("style:text-emphasize", "none");
+      state.m_font.edit().m_propertyList.insert("style:text-emphasize", "none");
   }
 }
 
 void StarCAttributeVoid::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_TXT_SOFTHYPH)
-    state.m_font.m_softHyphen=true;
+    state.m_font.edit().m_softHyphen=true;
 }
 
 }
@@ -833,26 +833,26 @@ void StarCAttributeEscapement::addTo(StarState &state, std::set<StarAttribute co
 {
   std::stringstream s;
   s << m_delta << "% " << m_scale << "%";
-  state.m_font.m_propertyList.insert("style:text-position", s.str().c_str());
+  state.m_font.edit().m_propertyList.insert("style:text-position", s.str().c_str());
 }
 
 void StarCAttributeFont::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (!m_name.empty()) {
     if (m_type==ATTR_CHR_FONT)
-      state.m_font.m_propertyList.insert("style:font-name", m_name);
+      state.m_font.edit().m_propertyList.insert("style:font-name", m_name);
     else if (m_type==ATTR_CHR_CJK_FONT)
-      state.m_font.m_propertyList.insert("style:font-name-asian", m_name);
+      state.m_font.edit().m_propertyList.insert("style:font-name-asian", m_name);
     else if (m_type==ATTR_CHR_CTL_FONT)
-      state.m_font.m_propertyList.insert("style:font-name-complex", m_name);
+      state.m_font.edit().m_propertyList.insert("style:font-name-complex", m_name);
   }
   if (m_pitch==1 || m_pitch==2) {
     if (m_type==ATTR_CHR_FONT)
-      state.m_font.m_propertyList.insert("style:font-pitch", m_pitch==1 ? "fixed" : "variable");
+      state.m_font.edit().m_propertyList.insert("style:font-pitch", m_pitch==1 ? "fixed" : "variable");
     else if (m_type==ATTR_CHR_CJK_FONT)
-      state.m_font.m_propertyList.insert("style:font-pitch-asian", m_pitch==1 ? "fixed" : "variable");
+      state.m_font.edit().m_propertyList.insert("style:font-pitch-asian", m_pitch==1 ? "fixed" : "variable");
     else if (m_type==ATTR_CHR_CTL_FONT)
-      state.m_font.m_propertyList.insert("style:font-pitch-complex", m_pitch==1 ? "fixed" : "variable");
+      state.m_font.edit().m_propertyList.insert("style:font-pitch-complex", m_pitch==1 ? "fixed" : "variable");
   }
   // TODO m_style, m_family
 }
@@ -868,43 +868,43 @@ void StarCAttributeFontSize::addTo(StarState &state, std::set<StarAttribute cons
   // TODO: use m_proportion?
   switch (m_unit) {
   case 0:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)*0.02756, librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)*0.02756, librevenge::RVNG_POINT);
     break;
   case 1:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)*0.2756, librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)*0.2756, librevenge::RVNG_POINT);
     break;
   case 2:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)*2.756, librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)*2.756, librevenge::RVNG_POINT);
     break;
   case 3:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)*27.56, librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)*27.56, librevenge::RVNG_POINT);
     break;
   case 4:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)/1000., librevenge::RVNG_INCH);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)/1000., librevenge::RVNG_INCH);
     break;
   case 5:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)/100., librevenge::RVNG_INCH);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)/100., librevenge::RVNG_INCH);
     break;
   case 6:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)/10., librevenge::RVNG_INCH);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)/10., librevenge::RVNG_INCH);
     break;
   case 7:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size), librevenge::RVNG_INCH);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size), librevenge::RVNG_INCH);
     break;
   case 8:
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size), librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size), librevenge::RVNG_POINT);
     break;
   case 9: // TWIP
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)/20., librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)/20., librevenge::RVNG_POINT);
     break;
   case 10: // pixel
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size), librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size), librevenge::RVNG_POINT);
     break;
   case 13: // rel, checkme
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)*state.m_global->m_relativeUnit, librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)*state.m_global->m_relativeUnit, librevenge::RVNG_POINT);
     break;
   default: // checkme
-    state.m_font.m_propertyList.insert(wh.c_str(), double(m_size)/20., librevenge::RVNG_POINT);
+    state.m_font.edit().m_propertyList.insert(wh.c_str(), double(m_size)/20., librevenge::RVNG_POINT);
     break;
   }
 }
@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -1439,7 +1440,8 @@ bool StarEncoding::read
     break;
   }
   if (!unicode) {
-    static int numError=0;
+    // can be called by the threads which read the spreadsheet tables
+    static std::atomic<int> numError(0);
     if (++numError<10) {
       STOFF_DEBUG_MSG(("StarEncoding::read: unknown caracter %x\n", static_cast<unsigned int>(c)));
     }
@@ -72,6 +72,38 @@ public:
     E_UCS4=0xFFFE,E_UCS2=0xFFFF
   };
 
+  /** \brief a row of a double byte encoding table
+
+      The double byte encodings are decoded using two-level tables:
+      the lead byte gives a row and the trail byte an entry in this row.
+      The unicode of the trail bytes in [m_first,m_last] are stored in
+      a value table(beginning at m_offset), the other trail bytes are
+      decoded using m_default.
+   */
+  struct DBCSRow {
+    //! the decoding method used for the trail bytes outside [m_first,m_last]
+    enum Default { D_Value=0 /** m_value*/, D_Lead /** the lead byte*/, D_LeadTrail /** (lead<<8)+trail*/ };
+    //! returns the unicode corresponding to a lead and a trail byte
+    uint32_t getUnicode(int lead, int trail, uint16_t const *values) const
+    {
+      if (trail>=m_first && trail<=m_last)
+        return values[m_offset+trail-m_first];
+      if (m_default==D_LeadTrail)
+        return uint32_t((lead<<8)+trail);
+      return m_default==D_Lead ? uint32_t(lead) : uint32_t(m_value);
+    }
+    //! the first position in the value table
+    uint16_t m_offset;
+    //! the first trail byte stored in the value table
+    uint8_t m_first;
+    //! the last trail byte stored in the value table
+    uint8_t m_last;
+    //! the default method
+    uint8_t m_default;
+    //! the default value (if m_default==D_Value)
+    uint16_t m_value;
+  };
+
   //! constructor
   StarEncoding();
   //! destructor
@@ -31,11 +31,14 @@
 * instead of those above.
 */
 
+#include <atomic>
+#include <cmath>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <stack>
 
 #include <librevenge/librevenge.h>
 
@@ -50,11 +53,16 @@
 #include "StarObjectSpreadsheet.hxx"
 #include "StarObjectText.hxx"
 #include "StarItemPool.hxx"
+#include "STOFFFont.hxx"
 #include "STOFFGraphicEncoder.hxx"
 #include "STOFFGraphicListener.hxx"
+#include "STOFFGraphicShape.hxx"
+#include "STOFFGraphicStyle.hxx"
 #include "STOFFPageSpan.hxx"
+#include "STOFFPosition.hxx"
 #include "STOFFSpreadsheetEncoder.hxx"
 #include "STOFFSpreadsheetListener.hxx"
+#include "STOFFSubDocument.hxx"
 
 #include "StarFileManager.hxx"
 
@@ -274,6 +282,294 @@ private:
   SfxMultiRecord &operator=(SfxMultiRecord const &orig);
 };
 
+////////////////////////////////////////
+//! Internal: the map mode of a SVGDI metafile
+struct SVGDIMapMode {
+  //! constructor
+  SVGDIMapMode()
+    : m_unit(0)
+    , m_origin(0,0)
+  {
+    for (auto &s : m_scale) s=1;
+  }
+  //! try to read a map mode
+  void read(STOFFInputStreamPtr input)
+  {
+    int16_t unit;
+    int32_t orgX, orgY, nXNum, nXDenom, nYNum, nYDenom;
+    *input >> unit >> orgX >> orgY >> nXNum >> nXDenom >> nYNum >> nYDenom;
+    m_unit=unit;
+    m_origin=STOFFVec2i(orgX, orgY);
+    m_scale[0]=nXDenom ? double(nXNum)/double(nXDenom) : 1;
+    m_scale[1]=nYDenom ? double(nYNum)/double(nYDenom) : 1;
+  }
+  //! returns the factor used to convert a unit in point
+  double getUnitFactor() const
+  {
+    // MAP_100TH_MM, MAP_10TH_MM, MAP_MM, MAP_CM, MAP_1000TH_INCH, MAP_100TH_INCH, MAP_10TH_INCH, MAP_INCH, MAP_POINT, MAP_TWIP, MAP_PIXEL
+    static double const factors[]= {72./2540., 72./254., 72./25.4, 72./2.54, 72./1000., 72./100., 72./10., 72., 1., 1./20., 0.75};
+    if (m_unit<0 || m_unit>=int(STOFF_N_ELEMENTS(factors))) {
+      // the preview can be read in a thread
+      static std::atomic<bool> first(true);
+      if (first.exchange(false)) {
+        STOFF_DEBUG_MSG(("StarFileManagerInternal::SVGDIMapMode::getUnitFactor: unknown unit %d\n", m_unit));
+      }
+      return factors[0];
+    }
+    return factors[m_unit];
+  }
+  //! converts a length in point
+  float getLength(int length, int coord) const
+  {
+    return float(double(length)*m_scale[coord]*getUnitFactor());
+  }
+  //! converts a position in point
+  STOFFVec2f getPoint(STOFFVec2i const &pt) const
+  {
+    return STOFFVec2f(getLength(pt[0]+m_origin[0],0), getLength(pt[1]+m_origin[1],1));
+  }
+  //! the unit
+  int m_unit;
+  //! the origin
+  STOFFVec2i m_origin;
+  //! the scaling
+  double m_scale[2];
+};
+
+////////////////////////////////////////
+//! Internal: the graphic state of a SVGDI metafile
+struct SVGDIGraphicState {
+  //! constructor
+  SVGDIGraphicState()
+    : m_mapMode()
+    , m_penColor(STOFFColor::black())
+    , m_penWidth(0)
+    , m_hasPen(true)
+    , m_fillColor(STOFFColor::white())
+    , m_hasFill(true)
+    , m_font()
+  {
+  }
+  //! the map mode
+  SVGDIMapMode m_mapMode;
+  //! the pen color
+  STOFFColor m_penColor;
+  //! the pen width
+  int m_penWidth;
+  //! a flag to know if the pen is defined
+  bool m_hasPen;
+  //! the fill color
+  STOFFColor m_fillColor;
+  //! a flag to know if the fill brush is defined
+  bool m_hasFill;
+  //! the font
+  STOFFFont m_font;
+};
+
+////////////////////////////////////////
+//! Internal: the subdocument used to send a SVGDI text
+class SVGDISubDocument final : public STOFFSubDocument
+{
+public:
+  //! constructor
+  SVGDISubDocument(librevenge::RVNGString const &text, STOFFFont const &font)
+    : STOFFSubDocument(nullptr, STOFFInputStreamPtr(), STOFFEntry())
+    , m_text(text)
+    , m_font(font)
+  {
+  }
+  //! destructor
+  ~SVGDISubDocument() final;
+  //! operator!=
+  bool operator!=(STOFFSubDocument const &doc) const final
+  {
+    if (STOFFSubDocument::operator!=(doc)) return true;
+    auto const *sDoc = dynamic_cast<SVGDISubDocument const *>(&doc);
+    if (!sDoc) return true;
+    return m_text!=sDoc->m_text || m_font!=sDoc->m_font;
+  }
+  //! the parser function
+  void parse(STOFFListenerPtr &listener, libstoff::SubDocumentType /*type*/) final
+  {
+    if (!listener) {
+      STOFF_DEBUG_MSG(("StarFileManagerInternal::SVGDISubDocument::parse: no listener\n"));
+      return;
+    }
+    listener->setFont(m_font);
+    listener->insertUnicodeString(m_text);
+  }
+protected:
+  //! the text
+  librevenge::RVNGString m_text;
+  //! the font
+  STOFFFont m_font;
+};
+
+SVGDISubDocument::~SVGDISubDocument()
+{
+}
+
+////////////////////////////////////////
+//! Internal: a structure used to send the actions of a SVGDI metafile to a listener
+struct SVGDISender {
+  //! constructor
+  explicit SVGDISender(STOFFListenerPtr listener)
+    : m_listener(listener)
+    , m_state()
+    , m_stateStack()
+  {
+  }
+  //! returns the current style
+  STOFFGraphicStyle getStyle(bool canBeFilled) const
+  {
+    STOFFGraphicStyle style;
+    auto &propList=style.m_propertyList;
+    if (m_state.m_hasPen) {
+      propList.insert("draw:stroke", "solid");
+      propList.insert("svg:stroke-color", m_state.m_penColor.str().c_str());
+      propList.insert("svg:stroke-width", double(m_state.m_mapMode.getLength(m_state.m_penWidth,0)), librevenge::RVNG_POINT);
+    }
+    else
+      propList.insert("draw:stroke", "none");
+    if (canBeFilled && m_state.m_hasFill) {
+      propList.insert("draw:fill", "solid");
+      propList.insert("draw:fill-color", m_state.m_fillColor.str().c_str());
+    }
+    else
+      propList.insert("draw:fill", "none");
+    return style;
+  }
+  //! returns a position anchored to the page
+  static STOFFPosition getPosition()
+  {
+    STOFFPosition pos;
+    pos.setAnchor(STOFFPosition::Page);
+    return pos;
+  }
+  //! converts a list of points in a property list vector
+  librevenge::RVNGPropertyListVector getPoints(std::vector<STOFFVec2i> const &points) const
+  {
+    librevenge::RVNGPropertyListVector vect;
+    for (auto const &pt : points) {
+      STOFFVec2f point=m_state.m_mapMode.getPoint(pt);
+      librevenge::RVNGPropertyList list;
+      list.insert("svg:x", double(point[0]), librevenge::RVNG_POINT);
+      list.insert("svg:y", double(point[1]), librevenge::RVNG_POINT);
+      vect.append(list);
+    }
+    return vect;
+  }
+  //! sends a line
+  void sendLine(STOFFVec2i const &pt0, STOFFVec2i const &pt1) const
+  {
+    sendPolygon(std::vector<STOFFVec2i> {pt0, pt1}, false);
+  }
+  //! sends a polygon or a polyline
+  void sendPolygon(std::vector<STOFFVec2i> const &points, bool isClosed) const
+  {
+    if (!m_listener || points.size()<2) return;
+    STOFFGraphicShape shape;
+    shape.m_command=isClosed ? STOFFGraphicShape::C_Polygon : STOFFGraphicShape::C_Polyline;
+    shape.m_propertyList.insert("svg:points", getPoints(points));
+    m_listener->insertShape(shape, getStyle(isClosed), getPosition());
+  }
+  //! sends a list of polygons
+  void sendPolyPolygon(std::vector<std::vector<STOFFVec2i> > const &polygons) const
+  {
+    if (!m_listener) return;
+    librevenge::RVNGPropertyListVector path;
+    for (auto const &poly : polygons) {
+      if (poly.size()<2) continue;
+      for (size_t p=0; p<poly.size(); ++p) {
+        STOFFVec2f point=m_state.m_mapMode.getPoint(poly[p]);
+        librevenge::RVNGPropertyList list;
+        list.insert("librevenge:path-action", p==0 ? "M" : "L");
+        list.insert("svg:x", double(point[0]), librevenge::RVNG_POINT);
+        list.insert("svg:y", double(point[1]), librevenge::RVNG_POINT);
+        path.append(list);
+      }
+      librevenge::RVNGPropertyList list;
+      list.insert("librevenge:path-action", "Z");
+      path.append(list);
+    }
+    if (!path.count()) return;
+    STOFFGraphicShape shape;
+    shape.m_command=STOFFGraphicShape::C_Path;
+    shape.m_propertyList.insert("svg:d", path);
+    m_listener->insertShape(shape, getStyle(true), getPosition());
+  }
+  //! sends a rectangle
+  void sendRectangle(STOFFBox2i const &box, STOFFVec2i const &round) const
+  {
+    if (!m_listener) return;
+    STOFFGraphicShape shape;
+    shape.m_command=STOFFGraphicShape::C_Rectangle;
+    shape.m_bdbox=STOFFBox2f(m_state.m_mapMode.getPoint(box[0]), m_state.m_mapMode.getPoint(box[1]));
+    if (round[0]>0 && round[1]>0) {
+      shape.m_propertyList.insert("svg:rx", double(m_state.m_mapMode.getLength(round[0],0)), librevenge::RVNG_POINT);
+      shape.m_propertyList.insert("svg:ry", double(m_state.m_mapMode.getLength(round[1],1)), librevenge::RVNG_POINT);
+    }
+    m_listener->insertShape(shape, getStyle(true), getPosition());
+  }
+  /** sends an ellipse, an arc (kind=1) or a pie (kind=2), the arc is defined from pt0 to pt1 */
+  void sendEllipse(STOFFBox2i const &box, int kind, STOFFVec2i const &pt0=STOFFVec2i(), STOFFVec2i const &pt1=STOFFVec2i()) const
+  {
+    if (!m_listener) return;
+    STOFFBox2f bdBox(m_state.m_mapMode.getPoint(box[0]), m_state.m_mapMode.getPoint(box[1]));
+    STOFFGraphicShape shape;
+    shape.m_command=STOFFGraphicShape::C_Ellipse;
+    STOFFVec2f center=bdBox.center();
+    shape.m_propertyList.insert("svg:cx", double(center[0]), librevenge::RVNG_POINT);
+    shape.m_propertyList.insert("svg:cy", double(center[1]), librevenge::RVNG_POINT);
+    shape.m_propertyList.insert("svg:rx", 0.5*double(bdBox.size()[0]), librevenge::RVNG_POINT);
+    shape.m_propertyList.insert("svg:ry", 0.5*double(bdBox.size()[1]), librevenge::RVNG_POINT);
+    if (kind) {
+      STOFFVec2f const pts[]= {m_state.m_mapMode.getPoint(pt0), m_state.m_mapMode.getPoint(pt1)};
+      for (int i=0; i<2; ++i) {
+        STOFFVec2f dir=pts[i]-center;
+        double angle=std::atan2(-double(dir[1]), double(dir[0]))*180/M_PI;
+        shape.m_propertyList.insert(i==0 ? "draw:start-angle" : "draw:end-angle", angle, librevenge::RVNG_GENERIC);
+      }
+      shape.m_propertyList.insert("draw:kind", kind==1 ? "arc" : "section");
+    }
+    m_listener->insertShape(shape, getStyle(kind!=1), getPosition());
+  }
+  //! sends a text, pos is the left baseline position of the text
+  void sendText(STOFFVec2i const &pos, std::vector<uint32_t> const &text) const
+  {
+    if (!m_listener || text.empty()) return;
+    float fontSize=12;
+    auto const *prop=m_state.m_font.m_propertyList["fo:font-size"];
+    if (prop) fontSize=float(prop->getDouble());
+    STOFFVec2f origin=m_state.m_mapMode.getPoint(pos);
+    STOFFPosition position=getPosition();
+    // the text's width is unknown, so use an approximation
+    position.setOrigin(origin-STOFFVec2f(0,fontSize), librevenge::RVNG_POINT);
+    position.setSize(STOFFVec2f(0.6f*fontSize*float(text.size()), 1.2f*fontSize), librevenge::RVNG_POINT);
+    STOFFGraphicStyle style;
+    style.m_propertyList.insert("draw:stroke", "none");
+    style.m_propertyList.insert("draw:fill", "none");
+    std::shared_ptr<SVGDISubDocument> doc(new SVGDISubDocument(libstoff::getString(text), m_state.m_font));
+    m_listener->insertTextBox(position, doc, style);
+  }
+  //! sends a bitmap
+  void sendBitmap(STOFFVec2i const &pos, STOFFVec2i const &size, librevenge::RVNGBinaryData const &data, std::string const &type) const
+  {
+    if (!m_listener || data.empty() || type.empty()) return;
+    STOFFPosition position=getPosition();
+    STOFFVec2f origin=m_state.m_mapMode.getPoint(pos);
+    position.setOrigin(origin, librevenge::RVNG_POINT);
+    position.setSize(m_state.m_mapMode.getPoint(pos+size)-origin, librevenge::RVNG_POINT);
+    m_listener->insertPicture(position, STOFFEmbeddedObject(data, type));
+  }
+  //! the listener
+  STOFFListenerPtr m_listener;
+  //! the current state
+  SVGDIGraphicState m_state;
+  //! the stack of state (see push/pop)
+  std::stack<SVGDIGraphicState> m_stateStack;
+};
+
 ////////////////////////////////////////
 //! Internal: the state of a StarFileManager
 struct State {
@@ -300,6 +596,7 @@ StarFileManager::~StarFileManager()
 bool StarFileManager::readOLEDirectory(std::shared_ptr<STOFFOLEParser> oleParser, std::shared_ptr<STOFFOLEParser::OleDirectory> ole, STOFFEmbeddedObject &image)
 {
   image=STOFFEmbeddedObject();
+  std::lock_guard<std::recursive_mutex> lock(libstoff::getInputMutex());
   if (!oleParser || !ole || ole->m_inUse) {
     STOFF_DEBUG_MSG(("StarFileManager::readOLEDirectory: can not read an ole\n"));
     return false;
@@ -674,8 +971,8 @@ try
       ascii.addPos(0);
       ascii.addNote(f.str().c_str());
       dataType=graphic.m_object.m_typeList.empty() ? "image/pict" : graphic.m_object.m_typeList[0];
-      if (!graphic.m_object.m_dataList.empty())
-        data=graphic.m_object.m_dataList[0];
+      if (graphic.m_object.size())
+        data=graphic.m_object.getData(0);
       extension="pict";
       return true;
     }
@@ -1108,7 +1405,47 @@ bool StarFileManager::readJobSetUp(StarZone &zone, bool useJobLen)
   return true;
 }
 
-bool StarFileManager::readSVGDI(StarZone &zone)
+bool StarFileManager::sendSVGDI(StarZone &zone, librevenge::RVNGDrawingInterface *documentInterface)
+{
+  STOFFInputStreamPtr input=zone.input();
+  if (!documentInterface || !input) {
+    STOFF_DEBUG_MSG(("StarFileManager::sendSVGDI: called without interface\n"));
+    return false;
+  }
+  // read the header to retrieve the picture size
+  long pos=input->tell();
+  std::string code;
+  for (int i=0; i<5; ++i) code+=char(input->readULong(1));
+  if (code!="SVGDI" || !input->checkPosition(pos+43)) {
+    input->seek(pos, librevenge::RVNG_SEEK_SET);
+    return false;
+  }
+  uint16_t sz;
+  int16_t version;
+  int32_t width, height;
+  *input >> sz >> version >> width >> height;
+  StarFileManagerInternal::SVGDIMapMode mapMode;
+  mapMode.read(input);
+  input->seek(pos, librevenge::RVNG_SEEK_SET);
+
+  STOFFPageSpan ps;
+  ps.m_pageSpan=1;
+  float const dim[]= {mapMode.getLength(width,0), mapMode.getLength(height,1)};
+  if (dim[0]>0 && dim[1]>0) {
+    ps.m_propertiesList[0].insert("fo:page-width", double(dim[0]), librevenge::RVNG_POINT);
+    ps.m_propertiesList[0].insert("fo:page-height", double(dim[1]), librevenge::RVNG_POINT);
+    for (auto const &wh : {"left", "top", "right", "bottom"})
+      ps.m_propertiesList[0].insert((std::string("fo:margin-")+wh).c_str(), 0., librevenge::RVNG_POINT);
+  }
+  std::vector<STOFFPageSpan> pageList(1, ps);
+  STOFFGraphicListenerPtr listener(new STOFFGraphicListener(STOFFListManagerPtr(), pageList, documentInterface));
+  listener->startDocument();
+  bool ok=readSVGDI(zone, listener);
+  listener->endDocument();
+  return ok;
+}
+
+bool StarFileManager::readSVGDI(StarZone &zone, STOFFListenerPtr listener)
 {
   STOFFInputStreamPtr input=zone.input();
   libstoff::DebugFile &ascFile=zone.ascii();
@@ -1137,13 +1474,19 @@ bool StarFileManager::readSVGDI(StarZone &zone)
   }
   f << "size=" << width << "x" << height << ",";
   // map mode
+  StarFileManagerInternal::SVGDISender sender(listener);
   int16_t unit;
   int32_t orgX, orgY, nXNum, nXDenom, nYNum, nYDenom;
+  long mapPos=input->tell();
   *input >> unit >> orgX >> orgY >> nXNum >> nXDenom >> nYNum >> nYDenom;
   if (unit) f << "unit=" << unit << ",";
   f << "orig=" << orgX << "x" << orgY << ",";
   f << "x=" << nXNum << "/" << nXDenom << ",";
   f << "y=" << nYNum << "/" << nYDenom << ",";
+  if (listener) {
+    input->seek(mapPos, librevenge::RVNG_SEEK_SET);
+    sender.m_state.m_mapMode.read(input);
+  }
 
   int32_t nActions;
   *input >> nActions;
@@ -1173,7 +1516,9 @@ bool StarFileManager::readSVGDI(StarZone &zone)
     unsigned char col[3];
     STOFFColor color;
     int32_t nTmp, nTmp1;
+    int32_t dim[4];
     std::vector<uint32_t> text;
+    std::vector<STOFFVec2i> points;
     switch (type) {
     case 1:
       f << "pixel=" << input->readLong(4) << "x" << input->readLong(4) << ",";
@@ -1184,26 +1529,33 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       f << "point=" << input->readLong(4) << "x" << input->readLong(4) << ",";
       break;
     case 3:
-      f << "line=" << input->readLong(4) << "x" << input->readLong(4) << "<->"
-        << input->readLong(4) << "x" << input->readLong(4) << ",";
+      for (auto &d : dim) *input >> d;
+      f << "line=" << dim[0] << "x" << dim[1] << "<->" << dim[2] << "x" << dim[3] << ",";
+      sender.sendLine(STOFFVec2i(dim[0],dim[1]), STOFFVec2i(dim[2],dim[3]));
       break;
     case 4:
-      f << "rect=" << input->readLong(4) << "x" << input->readLong(4) << "<->"
-        << input->readLong(4) << "x" << input->readLong(4) << ",";
+      for (auto &d : dim) *input >> d;
+      f << "rect=" << dim[0] << "x" << dim[1] << "<->" << dim[2] << "x" << dim[3] << ",";
       *input >> nTmp >> nTmp1;
       if (nTmp || nTmp1) f << "round=" << nTmp << "x" << nTmp1 << ",";
+      sender.sendRectangle(STOFFBox2i(STOFFVec2i(dim[0],dim[1]), STOFFVec2i(dim[2],dim[3])), STOFFVec2i(nTmp,nTmp1));
       break;
     case 5:
-      f << "ellipse=" << input->readLong(4) << "x" << input->readLong(4) << "<->"
-        << input->readLong(4) << "x" << input->readLong(4) << ",";
+      for (auto &d : dim) *input >> d;
+      f << "ellipse=" << dim[0] << "x" << dim[1] << "<->" << dim[2] << "x" << dim[3] << ",";
+      sender.sendEllipse(STOFFBox2i(STOFFVec2i(dim[0],dim[1]), STOFFVec2i(dim[2],dim[3])), 0);
       break;
     case 6:
-    case 7:
-      f << (type==6 ? "arc" : "pie")<< "=" << input->readLong(4) << "x" << input->readLong(4) << "<->"
-        << input->readLong(4) << "x" << input->readLong(4) << ",";
-      f << "pt1=" << input->readLong(4) << "x" << input->readLong(4) << ",";
-      f << "pt2=" << input->readLong(4) << "x" << input->readLong(4) << ",";
+    case 7: {
+      for (auto &d : dim) *input >> d;
+      f << (type==6 ? "arc" : "pie")<< "=" << dim[0] << "x" << dim[1] << "<->" << dim[2] << "x" << dim[3] << ",";
+      STOFFVec2i pts[2];
+      for (auto &pt : pts) *input >> pt[0] >> pt[1];
+      f << "pt1=" << pts[0] << ",";
+      f << "pt2=" << pts[1] << ",";
+      sender.sendEllipse(STOFFBox2i(STOFFVec2i(dim[0],dim[1]), STOFFVec2i(dim[2],dim[3])), type==6 ? 1 : 2, pts[0], pts[1]);
       break;
+    }
     case 8:
     case 9:
       f << (type==8 ? "rect[invert]" : "rect[highlight") << "="
@@ -1220,8 +1572,14 @@ bool StarFileManager::readSVGDI(StarZone &zone)
         break;
       }
       f << "pts=[";
-      for (int pt=0; pt<int(nTmp); ++pt) f << input->readLong(4) << "x" << input->readLong(4) << ",";
+      libstoff::ParseGuard::checkAllocation(static_cast<unsigned long>(nTmp), sizeof(STOFFVec2i));
+      points.resize(size_t(nTmp));
+      for (auto &pt : points) {
+        *input >> pt[0] >> pt[1];
+        f << pt << ",";
+      }
       f << "],";
+      sender.sendPolygon(points, type==11);
       break;
     case 12:
     case 1024:
@@ -1230,16 +1588,26 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       f << (type==12 ? "polypoly" : type==1024 ? "transparent[comment]" :
             type==1025 ? "hatch[comment]" : "gradient[comment]") << ",";
       *input >> nTmp;
-      for (int poly=0; poly<int(nTmp); ++poly) {
-        *input >> nTmp1;
-        if (nTmp1<0 || (endDataPos-input->tell())/8<nTmp1 || input->tell()+8*nTmp1>endDataPos) {
-          STOFF_DEBUG_MSG(("StarFileManager::readSVGDI: bad number of points\n"));
-          f << "###poly[nPts=" << nTmp1 << "],";
-          break;
+      {
+        std::vector<std::vector<STOFFVec2i> > polygons;
+        for (int poly=0; poly<int(nTmp); ++poly) {
+          *input >> nTmp1;
+          if (nTmp1<0 || (endDataPos-input->tell())/8<nTmp1 || input->tell()+8*nTmp1>endDataPos) {
+            STOFF_DEBUG_MSG(("StarFileManager::readSVGDI: bad number of points\n"));
+            f << "###poly[nPts=" << nTmp1 << "],";
+            break;
+          }
+          f << "poly" << poly << "=[";
+          polygons.push_back(std::vector<STOFFVec2i>(size_t(nTmp1)));
+          for (auto &pt : polygons.back()) {
+            *input >> pt[0] >> pt[1];
+            f << pt << ",";
+          }
+          f << "],";
         }
-        f << "poly" << poly << "=[";
-        for (int pt=0; pt<int(nTmp1); ++pt) f << input->readLong(4) << "x" << input->readLong(4) << ",";
-        f << "],";
+        // the comment actions only precede some actions which define the same shapes
+        if (type==12)
+          sender.sendPolyPolygon(polygons);
       }
       if (type==1024) {
         f << "nTrans=" << input->readULong(2) << ",";
@@ -1261,7 +1629,9 @@ bool StarFileManager::readSVGDI(StarZone &zone)
     case 13:
     case 15: {
       f << (type==13 ? "text" : "stretch") << ",";
-      f << "pos=" << input->readLong(4) << "x" << input->readLong(4) << ",";
+      STOFFVec2i textPos;
+      *input >> textPos[0] >> textPos[1];
+      f << "pos=" << textPos << ",";
       int32_t nIndex, nLen;
       *input>>nIndex>>nLen >> nTmp;
       if (nIndex) f << "index=" << nIndex << ",";
@@ -1276,7 +1646,10 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       for (int c=0; c<int(nTmp); ++c) text.push_back(static_cast<uint32_t>(input->readULong(1)));
       input->seek(1, librevenge::RVNG_SEEK_CUR);
       f << libstoff::getString(text).cstr() << ",";
-      if (nUnicodeCommentActionNumber!=static_cast<uint32_t>(i)) break;
+      if (nUnicodeCommentActionNumber!=static_cast<uint32_t>(i)) {
+        sender.sendText(textPos, text);
+        break;
+      }
       uint16_t type1;
       uint32_t len;
       *input >> type1 >> len;
@@ -1296,11 +1669,14 @@ bool StarFileManager::readSVGDI(StarZone &zone)
         f << "###unknown";
         input->seek(long(len)-4, librevenge::RVNG_SEEK_CUR);
       }
+      sender.sendText(textPos, text);
       break;
     }
     case 14: {
       f << "text[array],";
-      f << "pos=" << input->readLong(4) << "x" << input->readLong(4) << ",";
+      STOFFVec2i textPos;
+      *input >> textPos[0] >> textPos[1];
+      f << "pos=" << textPos << ",";
       int32_t nIndex, nLen, nAryLen;
       *input>>nIndex>>nLen >> nTmp >> nAryLen;
       if (nTmp<0 || nAryLen<0 || input->tell()+nTmp+4*nAryLen>endDataPos ||
@@ -1316,7 +1692,10 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       f << "ary=[";
       for (int ary=0; ary<int(nAryLen); ++ary) f << input->readLong(4) << ",";
       f << "],";
-      if (nUnicodeCommentActionNumber!=static_cast<uint32_t>(i)) break;
+      if (nUnicodeCommentActionNumber!=static_cast<uint32_t>(i)) {
+        sender.sendText(textPos, text);
+        break;
+      }
       uint16_t type1;
       uint32_t len;
       *input >> type1 >> len;
@@ -1336,7 +1715,7 @@ bool StarFileManager::readSVGDI(StarZone &zone)
         f << "###unknown";
         input->seek(long(len)-4, librevenge::RVNG_SEEK_CUR);
       }
-
+      sender.sendText(textPos, text);
       break;
     }
     case 16:
@@ -1347,8 +1726,13 @@ bool StarFileManager::readSVGDI(StarZone &zone)
     case 18:
     case 32: {
       f << (type==17 ? "bitmap" : type==18 ? "bitmap[scale]" : "bitmap[scale2]");
-      f << "pos=" << input->readLong(4) << "x" << input->readLong(4) << ",";
-      if (type>=17) f << "scale=" << input->readLong(4) << "x" << input->readLong(4) << ",";
+      STOFFVec2i bitmapPos, bitmapSize;
+      *input >> bitmapPos[0] >> bitmapPos[1];
+      f << "pos=" << bitmapPos << ",";
+      if (type>=17) {
+        *input >> bitmapSize[0] >> bitmapSize[1];
+        f << "scale=" << bitmapSize << ",";
+      }
       if (type==32) {
         f << "pos2=" << input->readLong(4) << "x" << input->readLong(4) << ",";
         f << "scale2=" << input->readLong(4) << "x" << input->readLong(4) << ",";
@@ -1358,6 +1742,8 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       std::string dataType;
       if (!bitmap.readBitmap(zone, false, endDataPos, data, dataType))
         f << "###bitmap,";
+      else
+        sender.sendBitmap(bitmapPos, bitmapSize, data, dataType);
       break;
     }
     case 19:
@@ -1365,16 +1751,23 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       for (int c=0; c<3; ++c) col[c]=static_cast<unsigned char>(input->readULong(2)>>8);
       color=STOFFColor(col[0],col[1],col[2]);
       if (!color.isBlack()) f << "col=" << color << ",";
-      f << "penWidth=" << input->readULong(4) << ",";
-      f << "penStyle=" << input->readULong(2) << ",";
+      sender.m_state.m_penColor=color;
+      sender.m_state.m_penWidth=int(input->readULong(4));
+      f << "penWidth=" << sender.m_state.m_penWidth << ",";
+      nTmp=int32_t(input->readULong(2));
+      f << "penStyle=" << nTmp << ",";
+      sender.m_state.m_hasPen=nTmp!=0;
       break;
     case 20: {
       f << "font,";
+      STOFFFont font;
       for (int c=0; c<2; ++c) {
         for (int j=0; j<3; ++j) col[j]=static_cast<unsigned char>(input->readULong(2)>>8);
         color=STOFFColor(col[0],col[1],col[2]);
         if ((c==1&&!color.isWhite()) || (c==0&&!color.isBlack()))
           f << (c==0 ? "col" : "col[fill]") << "=" << color << ",";
+        if (c==0)
+          font.m_propertyList.insert("fo:color", color.str().c_str());
       }
       long actPos=input->tell();
       if (actPos+62>endDataPos) {
@@ -1389,8 +1782,13 @@ bool StarFileManager::readSVGDI(StarZone &zone)
         name+=ch;
       }
       f << name << ",";
+      if (!name.empty())
+        font.m_propertyList.insert("style:font-name", name.c_str());
       input->seek(actPos+32, librevenge::RVNG_SEEK_SET);
-      f << "size=" << input->readLong(4) << "x" << input->readLong(4) << ",";
+      *input >> dim[0] >> dim[1];
+      f << "size=" << dim[0] << "x" << dim[1] << ",";
+      if (dim[1])
+        font.m_propertyList.insert("fo:font-size", double(sender.m_state.m_mapMode.getLength(dim[1]<0 ? -dim[1] : dim[1],1)), librevenge::RVNG_POINT);
       int16_t nCharSet, nFamily, nPitch, nAlign, nWeight, nUnderline, nStrikeout, nCharOrient, nLineOrient;
       bool bItalic, bOutline, bShadow, bTransparent;
       *input >> nCharSet >> nFamily >> nPitch >> nAlign >> nWeight >> nUnderline >> nStrikeout >> nCharOrient >> nLineOrient;
@@ -1408,20 +1806,34 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       if (bOutline) f << "outline,";
       if (bShadow) f << "shadow,";
       if (bTransparent) f << "transparent,";
+      if (nWeight>=7) // WEIGHT_SEMIBOLD
+        font.m_propertyList.insert("fo:font-weight", "bold");
+      if (bItalic)
+        font.m_propertyList.insert("fo:font-style", "italic");
+      sender.m_state.m_font=font;
       break;
     }
     case 21: // unsure
     case 22:
       f << (type==21 ? "brush[back]" : "brush[fill]") << ",";
       for (int j=0; j<3; ++j) col[j]=static_cast<unsigned char>(input->readULong(2)>>8);
-      f << STOFFColor(col[0],col[1],col[2]) << ",";
+      color=STOFFColor(col[0],col[1],col[2]);
+      f << color << ",";
       input->seek(6, librevenge::RVNG_SEEK_CUR); // unknown
-      f << "style=" << input->readLong(2) << ",";
+      nTmp=int32_t(input->readLong(2));
+      f << "style=" << nTmp << ",";
       input->seek(2, librevenge::RVNG_SEEK_CUR); // unknown
+      if (type==22) {
+        sender.m_state.m_fillColor=color;
+        sender.m_state.m_hasFill=nTmp!=0;
+      }
       break;
     case 23:
       f << "map[mode],";
+      mapPos=input->tell();
       *input >> unit >> orgX >> orgY >> nXNum >> nXDenom >> nYNum >> nYDenom;
+      input->seek(mapPos, librevenge::RVNG_SEEK_SET);
+      sender.m_state.m_mapMode.read(input);
       if (unit) f << "unit=" << unit << ",";
       f << "orig=" << orgX << "x" << orgY << ",";
       f << "x=" << nXNum << "/" << nXDenom << ",";
@@ -1478,9 +1890,17 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       break;
     case 26:
       f << "push,";
+      sender.m_stateStack.push(sender.m_state);
       break;
     case 27:
       f << "pop,";
+      if (sender.m_stateStack.empty()) {
+        STOFF_DEBUG_MSG(("StarFileManager::readSVGDI: the stack is empty\n"));
+        f << "###";
+        break;
+      }
+      sender.m_state=sender.m_stateStack.top();
+      sender.m_stateStack.pop();
       break;
     case 28:
       f << "clip[move]=" << input->readLong(4) << "x" << input->readLong(4) << ",";
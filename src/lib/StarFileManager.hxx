@@ -95,8 +95,10 @@ public:
   static bool readJobSetUp(StarZone &zone, bool usePrinterLen);
   //! try to read a font
   static bool readFont(StarZone &zone);
-  //! try to read a SVGDI object
-  static bool readSVGDI(StarZone &zone);
+  //! try to read a SVGDI object, if listener is set, sends its actions to the listener
+  static bool readSVGDI(StarZone &zone, STOFFListenerPtr listener=STOFFListenerPtr());
+  //! try to read a SVGDI object and to send it in a one page drawing document
+  static bool sendSVGDI(StarZone &zone, librevenge::RVNGDrawingInterface *documentInterface);
 
 protected:
 
@@ -36,6 +36,7 @@
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <tuple>
 
 #include <librevenge/librevenge.h>
 
@@ -545,12 +546,18 @@ struct State {
   State()
     : m_idNumberFormatMap()
     , m_nameToFormatDefMap()
+    , m_numberingCacheMap()
+    , m_numberingStyleIdMap()
   {
   }
   //! a map id to number format
   std::map<unsigned, NumberFormatter> m_idNumberFormatMap;
   //! a map name to format definition
   std::map<librevenge::RVNGString, std::shared_ptr<StarFormatManagerInternal::FormatDef> > m_nameToFormatDefMap;
+  //! a map (format id, original format, original number format) to the final cell's format and numbering style
+  std::map<std::tuple<unsigned,int,int>, std::pair<STOFFCell::Format, librevenge::RVNGPropertyList> > m_numberingCacheMap;
+  //! a map numbering style's property string to numbering style id
+  std::map<librevenge::RVNGString, int> m_numberingStyleIdMap;
 };
 }
 
@@ -953,8 +960,10 @@ bool StarFormatManager::readNumberFormatter(StarZone &zone)
       form.m_subFormats[i]=subForm;
     }
     form.m_extra=f.str();
-    if (ok && m_state->m_idNumberFormatMap.find(unsigned(id))==m_state->m_idNumberFormatMap.end())
+    if (ok && m_state->m_idNumberFormatMap.find(unsigned(id))==m_state->m_idNumberFormatMap.end()) {
       m_state->m_idNumberFormatMap[unsigned(id)]=form;
+      m_state->m_numberingCacheMap.clear();
+    }
     else if (ok) {
       // FIXME: can happen in StarChartDocument which can have multible number formatter zones
       static bool first=true;
@@ -1135,6 +1144,38 @@ bool StarFormatManager::readSWPatternLCL(StarZone &zone)
 }
 
 void StarFormatManager::updateNumberingProperties(STOFFCell &cell) const
+{
+  if (!cell.getNumberingStyle().empty()) {
+    computeNumberingProperties(cell);
+    return;
+  }
+  auto const &format=cell.getFormat();
+  auto key=std::make_tuple(unsigned(cell.getCellStyle().m_format), int(format.m_format), int(format.m_numberFormat));
+  auto it=m_state->m_numberingCacheMap.find(key);
+  if (it==m_state->m_numberingCacheMap.end()) {
+    computeNumberingProperties(cell);
+    // store the result and give an unique identifier to each different numbering style
+    STOFFCell::Format finalFormat=cell.getFormat();
+    auto const &propList=cell.getNumberingStyle();
+    if (propList.empty())
+      finalFormat.m_numberingStyleId=-1;
+    else {
+      auto hashKey=propList.getPropString();
+      auto idIt=m_state->m_numberingStyleIdMap.find(hashKey);
+      if (idIt!=m_state->m_numberingStyleIdMap.end())
+        finalFormat.m_numberingStyleId=idIt->second;
+      else {
+        finalFormat.m_numberingStyleId=int(m_state->m_numberingStyleIdMap.size());
+        m_state->m_numberingStyleIdMap[hashKey]=finalFormat.m_numberingStyleId;
+      }
+    }
+    it=m_state->m_numberingCacheMap.insert(std::make_pair(key, std::make_pair(finalFormat, propList))).first;
+  }
+  cell.setFormat(it->second.first);
+  cell.setNumberingStyle(it->second.second);
+}
+
+void StarFormatManager::computeNumberingProperties(STOFFCell &cell) const
 {
   auto const &style=cell.getCellStyle();
   auto &propList=cell.getNumberingStyle();
@@ -112,9 +112,13 @@ public:
   //! try to read number formatter type
   bool readNumberFormatter(StarZone &zone);
 
-  //! try to update the cell's data
+  //! try to update the cell's data: format and numbering style
   void updateNumberingProperties(STOFFCell &cell) const;
 
+protected:
+  //! compute the cell's format and numbering style
+  void computeNumberingProperties(STOFFCell &cell) const;
+
   //
   // data
   //
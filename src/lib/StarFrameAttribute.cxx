@@ -183,7 +183,7 @@ StarFAttributeVoid::~StarFAttributeVoid()
 void StarFAttributeBool::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_FRM_LAYOUT_SPLIT)
-    state.m_frame.m_propertyList.insert("style:may-break-between-rows", m_value);
+    state.m_frame.edit().m_propertyList.insert("style:may-break-between-rows", m_value);
 }
 
 void StarFAttributeInt::addTo(StarState &/*state*/, std::set<StarAttribute const *> &/*done*/) const
@@ -610,22 +610,22 @@ void StarFAttributeBorder::addTo(StarState &state, std::set<StarAttribute const
     // graphic
     for (int i=0; i<4; ++i) {
       if (!m_borders[i].isEmpty())
-        m_borders[i].addTo(state.m_graphic.m_propertyList, wh[i]);
+        m_borders[i].addTo(state.m_graphic.edit().m_propertyList, wh[i]);
     }
     for (int i=0; i<4; ++i)
-      state.m_graphic.m_propertyList.insert((std::string("padding-")+wh[i]).c_str(), libstoff::convertMiniMToPoint(m_distances[i]), librevenge::RVNG_POINT);
+      state.m_graphic.edit().m_propertyList.insert((std::string("padding-")+wh[i]).c_str(), libstoff::convertMiniMToPoint(m_distances[i]), librevenge::RVNG_POINT);
 
     // paragraph
     for (int i=0; i<4; ++i)
-      m_borders[i].addTo(state.m_paragraph.m_propertyList, wh[i]);
+      m_borders[i].addTo(state.m_paragraph.edit().m_propertyList, wh[i]);
     // SW table
     for (int i=0; i<4; ++i)
-      m_borders[i].addTo(state.m_cell.m_propertyList, wh[i]);
+      m_borders[i].addTo(state.m_cell.edit().m_propertyList, wh[i]);
   }
   else if (m_type==ATTR_SC_BORDER) {
     // checkme what is m_distance?
     for (int i=0; i<4; ++i)
-      m_borders[i].addTo(state.m_cell.m_propertyList, wh[i]);
+      m_borders[i].addTo(state.m_cell.edit().m_propertyList, wh[i]);
   }
 }
 
@@ -634,13 +634,13 @@ void StarFAttributeBrush::addTo(StarState &state, std::set<StarAttribute const *
   // font
   if (m_type == ATTR_CHR_BACKGROUND) {
     if (m_brush.isEmpty())
-      state.m_font.m_propertyList.insert("fo:background-color", "transparent");
+      state.m_font.edit().m_propertyList.insert("fo:background-color", "transparent");
     else {
       STOFFColor color;
       if (m_brush.getColor(color))
-        state.m_font.m_propertyList.insert("fo:background-color", color.str().c_str());
+        state.m_font.edit().m_propertyList.insert("fo:background-color", color.str().c_str());
       else {
-        state.m_font.m_propertyList.insert("fo:background-color", "transparent");
+        state.m_font.edit().m_propertyList.insert("fo:background-color", "transparent");
         STOFF_DEBUG_MSG(("StarFrameAttribute::StarFAttributeBrush::addTo: can not set a font background\n"));
       }
     }
@@ -648,72 +648,72 @@ void StarFAttributeBrush::addTo(StarState &state, std::set<StarAttribute const *
   // graphic|para
   else if (m_type==ATTR_FRM_BACKGROUND) {
     if (m_brush.m_transparency>0 && m_brush.m_transparency<=255)
-      state.m_graphic.m_propertyList.insert("draw:opacity", 1.-double(m_brush.m_transparency)/255., librevenge::RVNG_PERCENT);
+      state.m_graphic.edit().m_propertyList.insert("draw:opacity", 1.-double(m_brush.m_transparency)/255., librevenge::RVNG_PERCENT);
     else
-      state.m_graphic.m_propertyList.insert("draw:opacity",1., librevenge::RVNG_PERCENT);
-    state.m_paragraph.m_propertyList.insert("fo:background-color", "transparent");
+      state.m_graphic.edit().m_propertyList.insert("draw:opacity",1., librevenge::RVNG_PERCENT);
+    state.m_paragraph.edit().m_propertyList.insert("fo:background-color", "transparent");
     // graphic
     if (m_brush.isEmpty())
-      state.m_graphic.m_propertyList.insert("draw:fill", "none");
+      state.m_graphic.edit().m_propertyList.insert("draw:fill", "none");
     else {
       STOFFColor color;
       if (m_brush.hasUniqueColor() && m_brush.getColor(color)) {
-        state.m_graphic.m_propertyList.insert("draw:fill", "solid");
-        state.m_graphic.m_propertyList.insert("draw:fill-color", color.str().c_str());
+        state.m_graphic.edit().m_propertyList.insert("draw:fill", "solid");
+        state.m_graphic.edit().m_propertyList.insert("draw:fill-color", color.str().c_str());
 
         // para
-        state.m_paragraph.m_propertyList.insert("fo:background-color", color.str().c_str());
+        state.m_paragraph.edit().m_propertyList.insert("fo:background-color", color.str().c_str());
       }
       else {
         STOFFEmbeddedObject object;
         STOFFVec2i size;
         if (m_brush.getPattern(object, size) && object.m_dataList.size()) {
-          state.m_graphic.m_propertyList.insert("draw:fill", "bitmap");
-          state.m_graphic.m_propertyList.insert("draw:fill-image", object.m_dataList[0].getBase64Data());
-          state.m_graphic.m_propertyList.insert("draw:fill-image-width", size[0], librevenge::RVNG_POINT);
-          state.m_graphic.m_propertyList.insert("draw:fill-image-height", size[1], librevenge::RVNG_POINT);
-          state.m_graphic.m_propertyList.insert("draw:fill-image-ref-point-x",0, librevenge::RVNG_POINT);
-          state.m_graphic.m_propertyList.insert("draw:fill-image-ref-point-y",0, librevenge::RVNG_POINT);
-          state.m_graphic.m_propertyList.insert("librevenge:mime-type", object.m_typeList.empty() ? "image/pict" : object.m_typeList[0].c_str());
+          state.m_graphic.edit().m_propertyList.insert("draw:fill", "bitmap");
+          state.m_graphic.edit().m_propertyList.insert("draw:fill-image", object.m_dataList[0].getBase64Data());
+          state.m_graphic.edit().m_propertyList.insert("draw:fill-image-width", size[0], librevenge::RVNG_POINT);
+          state.m_graphic.edit().m_propertyList.insert("draw:fill-image-height", size[1], librevenge::RVNG_POINT);
+          state.m_graphic.edit().m_propertyList.insert("draw:fill-image-ref-point-x",0, librevenge::RVNG_POINT);
+          state.m_graphic.edit().m_propertyList.insert("draw:fill-image-ref-point-y",0, librevenge::RVNG_POINT);
+          state.m_graphic.edit().m_propertyList.insert("librevenge:mime-type", object.m_typeList.empty() ? "image/pict" : object.m_typeList[0].c_str());
         }
         else
-          state.m_graphic.m_propertyList.insert("draw:fill", "none");
+          state.m_graphic.edit().m_propertyList.insert("draw:fill", "none");
       }
     }
     // SW table
     if (m_brush.isEmpty())
-      state.m_cell.m_propertyList.insert("fo:background-color", "transparent");
+      state.m_cell.edit().m_propertyList.insert("fo:background-color", "transparent");
     else {
       STOFFColor color;
       if (m_brush.getColor(color))
-        state.m_cell.m_propertyList.insert("fo:background-color", color.str().c_str());
+        state.m_cell.edit().m_propertyList.insert("fo:background-color", color.str().c_str());
       else {
         STOFF_DEBUG_MSG(("StarFrameAttribute::StarFAttributeBrush::addTo: can not set a cell background\n"));
-        state.m_cell.m_propertyList.insert("fo:background-color", "transparent");
+        state.m_cell.edit().m_propertyList.insert("fo:background-color", "transparent");
       }
     }
   }
   // cell
   else if (m_type == ATTR_SC_BACKGROUND) {
     if (m_brush.isEmpty()) {
-      state.m_cell.m_propertyList.insert("fo:background-color", "transparent");
+      state.m_cell.edit().m_propertyList.insert("fo:background-color", "transparent");
       return;
     }
 
     STOFFColor color;
 #if 1
     if (m_brush.getColor(color)) {
-      state.m_cell.m_propertyList.insert("fo:background-color", color.str().c_str());
+      state.m_cell.edit().m_propertyList.insert("fo:background-color", color.str().c_str());
       return;
     }
     STOFF_DEBUG_MSG(("StarFrameAttribute::StarFAttributeBrush::addTo: can not set a cell background\n"));
-    state.m_cell.m_propertyList.insert("fo:background-color", "transparent");
+    state.m_cell.edit().m_propertyList.insert("fo:background-color", "transparent");
 #else
     /* checkme, is it possible to use style:background-image here ?
        Can not create any working ods file with bitmap cell's background...
     */
     if (m_brush.hasUniqueColor() && m_brush.getColor(color)) {
-      state.m_cell.m_propertyList.insert("fo:background-color", color.str().c_str());
+      state.m_cell->m_propertyList.insert("fo:background-color", color.str().c_str());
       return;
     }
     STOFFEmbeddedObject object;
@@ -735,7 +735,7 @@ void StarFAttributeBrush::addTo(StarState &state, std::set<StarAttribute const *
       }
       librevenge::RVNGPropertyListVector backgroundVector;
       backgroundVector.append(backgroundList);
-      state.m_cell.m_propertyList.insert("librevenge:background-image", backgroundVector);
+      state.m_cell->m_propertyList.insert("librevenge:background-image", backgroundVector);
     }
     else {
       STOFF_DEBUG_MSG(("StarFrameAttribute::StarFAttributeBrush::addTo: can not set a cell background\n"));
@@ -748,12 +748,12 @@ void StarFAttributeFrameSize::addTo(StarState &state, std::set<StarAttribute con
 {
   if (m_type==ATTR_FRM_FRM_SIZE) {
     if (m_width>0) {
-      state.m_frame.m_frameSize[0]=float(m_width)*0.05f;
-      state.m_global->m_page.m_propertiesList[0].insert("fo:page-width", double(state.m_frame.m_frameSize[0]), librevenge::RVNG_POINT);
+      state.m_frame.edit().m_frameSize[0]=float(m_width)*0.05f;
+      state.m_global->m_page.m_propertiesList[0].insert("fo:page-width", double(state.m_frame->m_frameSize[0]), librevenge::RVNG_POINT);
     }
     if (m_height>0) {
-      state.m_frame.m_frameSize[1]=float(m_height)*0.05f;
-      state.m_global->m_page.m_propertiesList[0].insert("fo:page-height", double(state.m_frame.m_frameSize[1]), librevenge::RVNG_POINT);
+      state.m_frame.edit().m_frameSize[1]=float(m_height)*0.05f;
+      state.m_global->m_page.m_propertiesList[0].insert("fo:page-height", double(state.m_frame->m_frameSize[1]), librevenge::RVNG_POINT);
     }
   }
 }
@@ -762,8 +762,8 @@ void StarFAttributeLineNumbering::addTo(StarState &state, std::set<StarAttribute
 {
   if (m_type==ATTR_FRM_LINENUMBER) {
     if (m_start>=0 && m_countLines) {
-      state.m_paragraph.m_propertyList.insert("text:number-lines", true);
-      state.m_paragraph.m_propertyList.insert("text:line-number", m_start==0 ? 1 : int(m_start));
+      state.m_paragraph.edit().m_propertyList.insert("text:number-lines", true);
+      state.m_paragraph.edit().m_propertyList.insert("text:line-number", m_start==0 ? 1 : int(m_start));
     }
   }
 }
@@ -773,20 +773,20 @@ void StarFAttributeLRSpace::addTo(StarState &state, std::set<StarAttribute const
   // paragraph
   if (m_type==ATTR_FRM_LR_SPACE || m_type==ATTR_EE_PARA_OUTLLR_SPACE) {
     if (m_propMargins[0]==100) // unsure if/when we need to use textLeft/margins[0] here
-      state.m_paragraph.m_propertyList.insert("fo:margin-left", state.m_global->m_relativeUnit*double(m_textLeft), librevenge::RVNG_POINT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:margin-left", state.m_global->m_relativeUnit*double(m_textLeft), librevenge::RVNG_POINT);
     else
-      state.m_paragraph.m_propertyList.insert("fo:margin-left", double(m_propMargins[0])/100., librevenge::RVNG_PERCENT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:margin-left", double(m_propMargins[0])/100., librevenge::RVNG_PERCENT);
 
     if (m_propMargins[1]==100)
-      state.m_paragraph.m_propertyList.insert("fo:margin-right", state.m_global->m_relativeUnit*double(m_margins[1]), librevenge::RVNG_POINT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:margin-right", state.m_global->m_relativeUnit*double(m_margins[1]), librevenge::RVNG_POINT);
     else
-      state.m_paragraph.m_propertyList.insert("fo:margin-right", double(m_propMargins[1])/100., librevenge::RVNG_PERCENT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:margin-right", double(m_propMargins[1])/100., librevenge::RVNG_PERCENT);
     if (m_propMargins[2]==100)
-      state.m_paragraph.m_propertyList.insert("fo:text-indent", state.m_global->m_relativeUnit*double(m_margins[2]), librevenge::RVNG_POINT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-indent", state.m_global->m_relativeUnit*double(m_margins[2]), librevenge::RVNG_POINT);
     else
-      state.m_paragraph.m_propertyList.insert("fo:text-indent", double(m_propMargins[2])/100., librevenge::RVNG_PERCENT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-indent", double(m_propMargins[2])/100., librevenge::RVNG_PERCENT);
     // m_textLeft: ok to ignore ?
-    state.m_paragraph.m_propertyList.insert("style:auto-text-indent", m_autoFirst);
+    state.m_paragraph.edit().m_propertyList.insert("style:auto-text-indent", m_autoFirst);
   }
   // page
   if (m_type==ATTR_FRM_LR_SPACE && state.m_global->m_pageZone>=0 && state.m_global->m_pageZone<=2) {
@@ -812,7 +812,7 @@ void StarFAttributeOrientation::addTo(StarState &state, std::set<StarAttribute c
     case 2:
     case 3: { // CHECKME
       char const *(wh[])= {"start", "center", "left"};
-      state.m_frame.m_propertyList.insert("fo:text-align", wh[m_orient-1]);
+      state.m_frame.edit().m_propertyList.insert("fo:text-align", wh[m_orient-1]);
       break;
     }
     default: // TODO
@@ -827,7 +827,7 @@ void StarFAttributeOrientation::addTo(StarState &state, std::set<StarAttribute c
     case 2:
     case 3: {
       char const *(wh[])= {"top", "middle", "bottom"};
-      state.m_frame.m_propertyList.insert("style:vertical-align", wh[m_orient-1]);
+      state.m_frame.edit().m_propertyList.insert("style:vertical-align", wh[m_orient-1]);
       break;
     }
     default: // TODO
@@ -840,23 +840,23 @@ void StarFAttributeShadow::addTo(StarState &state, std::set<StarAttribute const
 {
   // graphic
   if (m_width<=0 || m_location<=0 || m_location>4 || m_transparency<0 || m_transparency>=255)
-    state.m_graphic.m_propertyList.insert("draw:shadow", "hidden");
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow", "hidden");
   else {
-    state.m_graphic.m_propertyList.insert("draw:shadow", "visible");
-    state.m_graphic.m_propertyList.insert("draw:shadow-color", m_color.str().c_str());
-    state.m_graphic.m_propertyList.insert("draw:shadow-opacity", 1.-double(m_transparency)/255., librevenge::RVNG_PERCENT);
-    state.m_graphic.m_propertyList.insert("draw:shadow-offset-x", ((m_location%2)?-1:1)*libstoff::convertMiniMToPoint(m_width), librevenge::RVNG_POINT);
-    state.m_graphic.m_propertyList.insert("draw:shadow-offset-y", (m_location<=2?-1:1)*libstoff::convertMiniMToPoint(m_width), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow", "visible");
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow-color", m_color.str().c_str());
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow-opacity", 1.-double(m_transparency)/255., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow-offset-x", ((m_location%2)?-1:1)*libstoff::convertMiniMToPoint(m_width), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow-offset-y", (m_location<=2?-1:1)*libstoff::convertMiniMToPoint(m_width), librevenge::RVNG_POINT);
   }
   // cell
   if (m_width<=0 || m_location<=0 || m_location>4 || m_transparency<0 || m_transparency>=100)
-    state.m_cell.m_propertyList.insert("style:shadow", "none");
+    state.m_cell.edit().m_propertyList.insert("style:shadow", "none");
   else {
     std::stringstream s;
     s << m_color.str().c_str() << " "
       << ((m_location%2)?-1:1)*double(m_width)/20. << "pt "
       << (m_location<=2?-1:1)*double(m_width)/20. << "pt";
-    state.m_cell.m_propertyList.insert("style:shadow", s.str().c_str());
+    state.m_cell.edit().m_propertyList.insert("style:shadow", s.str().c_str());
   }
 }
 
@@ -865,14 +865,14 @@ void StarFAttributeULSpace::addTo(StarState &state, std::set<StarAttribute const
   // paragraph
   if (m_type==ATTR_FRM_UL_SPACE) {
     if (m_propMargins[0]==100)
-      state.m_paragraph.m_propertyList.insert("fo:margin-top", state.m_global->m_relativeUnit*double(m_margins[0]), librevenge::RVNG_POINT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:margin-top", state.m_global->m_relativeUnit*double(m_margins[0]), librevenge::RVNG_POINT);
     else
-      state.m_paragraph.m_propertyList.insert("fo:margin-top", double(m_propMargins[0])/100., librevenge::RVNG_PERCENT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:margin-top", double(m_propMargins[0])/100., librevenge::RVNG_PERCENT);
 
     if (m_propMargins[1]==100)
-      state.m_paragraph.m_propertyList.insert("fo:margin-bottom", state.m_global->m_relativeUnit*double(m_margins[1]), librevenge::RVNG_POINT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:margin-bottom", state.m_global->m_relativeUnit*double(m_margins[1]), librevenge::RVNG_POINT);
     else
-      state.m_paragraph.m_propertyList.insert("fo:margin-bottom", double(m_propMargins[1])/100., librevenge::RVNG_PERCENT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:margin-bottom", double(m_propMargins[1])/100., librevenge::RVNG_PERCENT);
   }
   // page
   if (m_type==ATTR_FRM_UL_SPACE && state.m_global->m_pageZone>=0 && state.m_global->m_pageZone<=2) {
@@ -613,16 +613,11 @@ bool StarGraphicStruct::StarGraphic::read(StarZone &zone, long endPos)
         pos=input->tell();
         f.str("");
         f << "SDRGraphic:native";
-        librevenge::RVNGBinaryData data;
-        if (!input->readDataBlock(size,data)) {
-          STOFF_DEBUG_MSG(("StarGraphicStruct::StarGraphic::read: can not save a Nat5 file\n"));
-          input->seek(pos, librevenge::RVNG_SEEK_SET);
-        }
-        else {
-          m_object.add(data, "image/pict");
-          ascFile.skipZone(pos,pos+size-1);
-          return true;
-        }
+        // the data are only read when the picture is sent
+        m_object.addLazy(input, pos, pos+size, "image/pict");
+        input->seek(pos+size, librevenge::RVNG_SEEK_SET);
+        ascFile.skipZone(pos,pos+size-1);
+        return true;
       }
       else if (ok) {
         STOFF_DEBUG_MSG(("StarGraphicStruct::StarGraphic::read: the picture size seems bad\n"));
@@ -635,15 +630,7 @@ bool StarGraphicStruct::StarGraphic::read(StarZone &zone, long endPos)
     StarFileManager fileManager;
     input->seek(-4, librevenge::RVNG_SEEK_CUR);
     if (fileManager.readSVGDI(zone)) {
-      long actPos=input->tell();
-      input->seek(pos, librevenge::RVNG_SEEK_SET);
-      librevenge::RVNGBinaryData data;
-      if (!input->readDataBlock(actPos-pos,data)) {
-        STOFF_DEBUG_MSG(("StarGraphicStruct::StarGraphic::read: can not save a SVGD file\n"));
-        input->seek(actPos, librevenge::RVNG_SEEK_SET);
-      }
-      else
-        m_object.add(data, "image/svg");
+      m_object.addLazy(input, pos, input->tell(), "image/svg");
       return true;
     }
 
@@ -679,6 +666,37 @@ bool StarGraphicStruct::StarGraphic::read(StarZone &zone, long endPos)
 }
 
 // StarPolygon
+bool StarPolygon::readPoints(StarZone &zone, size_t n, bool hasFlags)
+{
+  if (!n) return true;
+  STOFFInputStreamPtr input=zone.input();
+  size_t const dataSize=(hasFlags ? 9 : 8)*n;
+  unsigned long numRead;
+  uint8_t const *data=input->read(dataSize, numRead);
+  if (!data || numRead!=dataSize) {
+    STOFF_DEBUG_MSG(("StarGraphicStruct::StarPolygon::readPoints: can not read the points\n"));
+    return false;
+  }
+  bool const inverted=input->readInverted();
+  size_t const first=m_points.size();
+  libstoff::ParseGuard::checkAllocation(static_cast<unsigned long>(n), sizeof(Point));
+  m_points.resize(first+n);
+  for (size_t pt=0; pt<n; ++pt, data+=8) {
+    uint32_t dim[2];
+    for (int i=0; i<2; ++i) {
+      uint8_t const *c=data+4*i;
+      dim[i]=inverted ? (uint32_t(c[0])|(uint32_t(c[1])<<8)|(uint32_t(c[2])<<16)|(uint32_t(c[3])<<24)) :
+             (uint32_t(c[3])|(uint32_t(c[2])<<8)|(uint32_t(c[1])<<16)|(uint32_t(c[0])<<24));
+    }
+    m_points[first+pt].m_point=STOFFVec2i(int(int32_t(dim[0])),int(int32_t(dim[1])));
+  }
+  if (hasFlags) {
+    for (size_t pt=0; pt<n; ++pt)
+      m_points[first+pt].m_flags=int(*(data++));
+  }
+  return true;
+}
+
 void StarPolygon::addToPath(librevenge::RVNGPropertyListVector &path, bool isClosed) const
 {
   librevenge::RVNGPropertyList element;
@@ -181,6 +181,9 @@ public:
   {
     return m_points.size();
   }
+  /** reads n points stored as consecutive int32 pairs (followed by n
+      flag bytes if hasFlags) and appends them to the polygon */
+  bool readPoints(StarZone &zone, size_t n, bool hasFlags);
   //! add the polygon to a path
   void addToPath(librevenge::RVNGPropertyListVector &path, bool isClosed) const;
   //! convert a path in a string and update the bdbox
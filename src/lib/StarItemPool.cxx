@@ -36,6 +36,7 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <sstream>
 
@@ -287,10 +288,32 @@ struct Version {
     : m_version(vers)
     , m_start(start)
     , m_list(list)
-    , m_invertListMap()
+    , m_minValue(0)
+    , m_invertList()
   {
+    if (m_list.empty()) return;
+    auto minMax=std::minmax_element(m_list.begin(), m_list.end());
+    m_minValue=*minMax.first;
+    m_invertList.resize(size_t(*minMax.second-m_minValue+1), -1);
     for (size_t i=0; i<m_list.size(); ++i)
-      m_invertListMap[list[i]]=int(i);
+      m_invertList[size_t(m_list[i]-m_minValue)]=int(i);
+  }
+  //! returns the minimum value
+  int getMinValue() const
+  {
+    return m_minValue;
+  }
+  //! returns the maximum value
+  int getMaxValue() const
+  {
+    return m_minValue+int(m_invertList.size())-1;
+  }
+  //! returns the offset corresponding to a value or -1
+  int getOffset(int value) const
+  {
+    if (value<m_minValue || value>=m_minValue+int(m_invertList.size()))
+      return -1;
+    return m_invertList[size_t(value-m_minValue)];
   }
   //! the version number
   int m_version;
@@ -298,8 +321,11 @@ struct Version {
   int m_start;
   //! the list of value
   std::vector<int> m_list;
-  //! a map offset to which
-  std::map<int,int> m_invertListMap;
+protected:
+  //! the minimum value
+  int m_minValue;
+  //! a list value-m_minValue to offset (or -1)
+  std::vector<int> m_invertList;
 };
 
 //! internal: list of attribute corresponding to a slot id
@@ -307,13 +333,46 @@ struct Values {
   //! constructor
   Values()
     : m_default()
-    , m_idValueMap()
+    , m_idValueList()
+    , m_idDefinedList()
+    , m_numDefined(0)
+  {
+  }
+  //! returns true if no attribute are defined
+  bool empty() const
   {
+    return m_numDefined==0;
+  }
+  //! returns a pointer to the attribute corresponding to id or 0 if the attribute is not defined
+  std::shared_ptr<StarAttribute> const *find(int id) const
+  {
+    if (id<0 || id>=int(m_idDefinedList.size()) || !m_idDefinedList[size_t(id)])
+      return 0;
+    return &m_idValueList[size_t(id)];
+  }
+  //! sets the attribute corresponding to id
+  void set(int id, std::shared_ptr<StarAttribute> const &attribute)
+  {
+    if (id<0) return;
+    if (id>=int(m_idDefinedList.size())) {
+      m_idValueList.resize(size_t(id+1));
+      m_idDefinedList.resize(size_t(id+1), false);
+    }
+    if (!m_idDefinedList[size_t(id)]) {
+      m_idDefinedList[size_t(id)]=true;
+      ++m_numDefined;
+    }
+    m_idValueList[size_t(id)]=attribute;
   }
   //! the default values
   std::shared_ptr<StarAttribute> m_default;
-  //! the list of attribute
-  std::map<int,std::shared_ptr<StarAttribute> > m_idValueMap;
+protected:
+  //! the list of attribute: id to attribute
+  std::vector<std::shared_ptr<StarAttribute> > m_idValueList;
+  //! a flag to know if an attribute id is defined
+  std::vector<bool> m_idDefinedList;
+  //! the number of defined attributes
+  int m_numDefined;
 };
 
 ////////////////////////////////////////
@@ -366,9 +425,14 @@ struct State {
     , m_verEnd(0)
     , m_versionList()
     , m_idToAttributeList()
-    , m_slotIdToValuesMap()
+    , m_valuesFirstId(0)
+    , m_valuesList()
     , m_styleIdToStyleMap()
     , m_simplifyNameToStyleNameMap()
+    , m_findStyleCache()
+    , m_paragraphStyleCache()
+    , m_graphicStyleCache()
+    , m_cacheMutex()
     , m_idToDefaultMap()
     , m_delayedItemList()
   {
@@ -376,15 +440,25 @@ struct State {
   }
   //! initialize a pool
   void init(StarItemPool::Type type);
+  //! reset the caches computed from the styles
+  void resetStyleCaches()
+  {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_findStyleCache.clear();
+    m_paragraphStyleCache.clear();
+    m_graphicStyleCache.clear();
+  }
   //! clean the state
   void clean()
   {
     if (m_secondaryPool) m_secondaryPool->clean();
     m_versionList.clear();
     m_idToAttributeList.clear();
-    m_slotIdToValuesMap.clear();
+    m_valuesFirstId=0;
+    m_valuesList.clear();
     m_styleIdToStyleMap.clear();
     m_simplifyNameToStyleNameMap.clear();
+    resetStyleCaches();
     m_idToDefaultMap.clear();
     m_delayedItemList.clear();
   }
@@ -426,9 +500,9 @@ struct State {
     m_versionList.push_back(Version(int(nVers), int(nStart), list));
     m_currentVersion=nVers;
     Version const &vers=m_versionList.back();
-    if (vers.m_invertListMap.empty()) return;
-    m_verStart=std::min(m_verStart,vers.m_invertListMap.begin()->first);
-    m_verEnd=std::max(m_verEnd,(--vers.m_invertListMap.end())->first);
+    if (vers.m_list.empty()) return;
+    m_verStart=std::min(m_verStart,vers.getMinValue());
+    m_verEnd=std::max(m_verEnd,vers.getMaxValue());
   }
   //! try to return ???
   int getWhich(int nFileWhich) const
@@ -445,9 +519,10 @@ struct State {
         Version const &vers=m_versionList[--i];
         if (vers.m_version<=m_currentVersion)
           break;
-        if (vers.m_invertListMap.find(nFileWhich)==vers.m_invertListMap.end())
+        int offset=vers.getOffset(nFileWhich);
+        if (offset<0)
           return 0;
-        nFileWhich=vers.m_start+vers.m_invertListMap.find(nFileWhich)->second;
+        nFileWhich=vers.m_start+offset;
       }
     }
     else if (m_loadingVersion<m_currentVersion) {
@@ -474,12 +549,25 @@ struct State {
   //! returns a pointer to the values data
   Values *getValues(int id, bool create=false)
   {
-    if (m_slotIdToValuesMap.find(id)!=m_slotIdToValuesMap.end())
-      return &m_slotIdToValuesMap.find(id)->second;
-    if (!create)
+    if (id>=m_valuesFirstId && id<m_valuesFirstId+int(m_valuesList.size()))
+      return &m_valuesList[size_t(id-m_valuesFirstId)];
+    if (!create || id<0 || id>0xFFFF)
       return 0;
-    m_slotIdToValuesMap[id]=Values();
-    return &m_slotIdToValuesMap.find(id)->second;
+    // the first time, reserve the whole pool range, so that we rarely need to grow the list
+    int first=id, last=id;
+    if (!m_valuesList.empty()) {
+      first=std::min(id, m_valuesFirstId);
+      last=std::max(id, m_valuesFirstId+int(m_valuesList.size())-1);
+    }
+    else if (id>=m_verStart && id<=m_verEnd) {
+      first=m_verStart;
+      last=m_verEnd;
+    }
+    if (!m_valuesList.empty() && first<m_valuesFirstId)
+      m_valuesList.insert(m_valuesList.begin(), size_t(m_valuesFirstId-first), Values());
+    m_valuesFirstId=first;
+    m_valuesList.resize(size_t(last-first+1));
+    return &m_valuesList[size_t(id-m_valuesFirstId)];
   }
   //! try to return a default attribute corresponding to which
   std::shared_ptr<StarAttribute> getDefaultAttribute(int which)
@@ -524,12 +612,22 @@ struct State {
   std::vector<Version> m_versionList;
   //! list whichId to attribute list
   std::vector<int> m_idToAttributeList;
-  //! a map slot to the attribute list
-  std::map<int, Values> m_slotIdToValuesMap;
+  //! the first which id stored in m_valuesList
+  int m_valuesFirstId;
+  //! the attribute lists: which-m_valuesFirstId to values
+  std::vector<Values> m_valuesList;
   //! the set of style
   std::map<StyleId,StarItemStyle> m_styleIdToStyleMap;
   //! map simplify style name to style name
   std::map<librevenge::RVNGString, librevenge::RVNGString> m_simplifyNameToStyleNameMap;
+  //! cache of findStyleWithFamily: (name, requested family) to style, 0 if the style does not exist
+  std::map<StyleId, StarItemStyle const *> m_findStyleCache;
+  //! cache of the paragraph styles computed by defineParagraphStyle
+  std::map<librevenge::RVNGString, STOFFParagraph> m_paragraphStyleCache;
+  //! cache of the graphic styles computed by defineGraphicStyle
+  std::map<librevenge::RVNGString, STOFFGraphicStyle> m_graphicStyleCache;
+  //! the mutex used to protect the caches when the pages are sent in different threads
+  mutable std::mutex m_cacheMutex;
   //! map of created default attribute
   std::map<int,std::shared_ptr<StarAttribute> > m_idToDefaultMap;
   //! list of item which need to be read
@@ -1134,12 +1232,13 @@ bool StarItemPool::loadSurrogate(StarItem &item)
       item.m_attribute=values->m_default;
     return true;
   }
-  if (!values || values->m_idValueMap.find(item.m_surrogateId)==values->m_idValueMap.end()) {
+  auto const *attribute=values ? values->find(item.m_surrogateId) : 0;
+  if (!attribute) {
     STOFF_DEBUG_MSG(("StarItemPool::loadSurrogate: can not find the attribute array for %d[%d]\n", aWhich, item.m_surrogateId));
     item.m_attribute=m_state->getDefaultAttribute(aWhich);
     return true;
   }
-  item.m_attribute=values->m_idValueMap.find(item.m_surrogateId)->second;
+  item.m_attribute=*attribute;
 
   return true;
 }
@@ -1179,7 +1278,8 @@ std::shared_ptr<StarItem> StarItemPool::loadSurrogate(StarZone &zone, uint16_t &
     return res;
   }
   f << "surrog=" << nSurrog << ",";
-  if (!values || values->m_idValueMap.find(int(nSurrog))==values->m_idValueMap.end()) {
+  auto const *attribute=values ? values->find(int(nSurrog)) : 0;
+  if (!attribute) {
     if (isInside()) {
       // ok, we must wait that the pool is read
       return createItem(int(nWhich), int(nSurrog), localId);
@@ -1189,7 +1289,7 @@ std::shared_ptr<StarItem> StarItemPool::loadSurrogate(StarZone &zone, uint16_t &
     res->m_attribute=m_state->getDefaultAttribute(aWhich);
     return res;
   }
-  res->m_attribute=values->m_idValueMap.find(int(nSurrog))->second;
+  res->m_attribute=*attribute;
   return res;
 }
 
@@ -1378,7 +1478,7 @@ bool StarItemPool::readV2(StarZone &zone, StarItemPool *master)
       int aWhich=m_state->m_currentVersion!=m_state->m_loadingVersion ? m_state->getWhich(which) : which;
       StarItemPoolInternal::Values *values=m_state->getValues(aWhich, true);
       if (step==0) {
-        if (!values->m_idValueMap.empty()) {
+        if (!values->empty()) {
           STOFF_DEBUG_MSG(("StarItemPool::readV2: oops, there is already some attributes in values\n"));
         }
         StarItemPoolInternal::SfxMultiRecord mRecord1;
@@ -1408,12 +1508,12 @@ bool StarItemPool::readV2(StarZone &zone, StarItemPool *master)
               STOFF_DEBUG_MSG(("StarItemPool::readV2: find extra attrib data\n"));
               f << "###extra";
             }
-            if (values->m_idValueMap.find(id)!=values->m_idValueMap.end()) {
+            if (values->find(id)) {
               STOFF_DEBUG_MSG(("StarItemPool::readV2: find dupplicated attrib data in %d\n", id));
               f << "###id";
             }
             else
-              values->m_idValueMap[id]=attribute;
+              values->set(id, attribute);
             input->seek(mRecord1.getLastContentPosition(), librevenge::RVNG_SEEK_SET);
             ascii.addPos(pos);
             ascii.addNote(f.str().c_str());
@@ -1694,7 +1794,7 @@ bool StarItemPool::readV1(StarZone &zone, StarItemPool * /*master*/)
       int aWhich=m_state->m_currentVersion!=m_state->m_loadingVersion ? m_state->getWhich(which) : which;
       auto *values=m_state->getValues(aWhich, true);
       if (step==0 && nCount) {
-        if (!values->m_idValueMap.empty()) {
+        if (!values->empty()) {
           STOFF_DEBUG_MSG(("StarItemPool::readV1: the slot %d is already created\n", aWhich));
         }
       }
@@ -1724,7 +1824,7 @@ bool StarItemPool::readV1(StarZone &zone, StarItemPool * /*master*/)
           ascii.addPos(pos);
           ascii.addNote(f.str().c_str());
           if (step==0)
-            values->m_idValueMap[i]=attribute;
+            values->set(i, attribute);
           continue;
         }
 
@@ -1739,7 +1839,7 @@ bool StarItemPool::readV1(StarZone &zone, StarItemPool * /*master*/)
             f << "###";
         }
         if (step==0)
-          values->m_idValueMap[i]=attribute;
+          values->set(i, attribute);
         else
           values->m_default=attribute;
         if (input->tell()!=debAttPos+long(sizeAttr[n])) {
@@ -1923,8 +2023,10 @@ bool StarItemPool::readStyles(StarZone &zone, StarObject &doc)
     if (m_state->m_styleIdToStyleMap.find(styleId)!=m_state->m_styleIdToStyleMap.end()) {
       STOFF_DEBUG_MSG(("StarItemPool::readStyles: style %s-%d\n", style.m_names[0].cstr(), style.m_family));
     }
-    else
+    else {
       m_state->m_styleIdToStyleMap[styleId]=style;
+      m_state->resetStyleCaches();
+    }
     f << style;
     ascii.addDelimiter(input->tell(),'|');
     uint16_t nVer;
@@ -2056,6 +2158,8 @@ void StarItemPool::updateStyles()
   std::set<StarItemPoolInternal::StyleId> done, toDo;
   std::multimap<StarItemPoolInternal::StyleId, StarItemPoolInternal::StyleId> childMap;
   std::map<int, std::shared_ptr<StarItem> >::const_iterator iIt;
+  // the item sets will be merged, so forget all the previously resolved styles
+  m_state->resetStyleCaches();
   for (auto it : m_state->m_styleIdToStyleMap) {
     if (it.second.m_names[1].empty())
       toDo.insert(it.first);
@@ -2110,7 +2214,7 @@ void StarItemPool::updateStyles()
      from a bad encoded style name...
    */
   std::set<librevenge::RVNGString> dupplicatedSimpName;
-  for (auto it : m_state->m_styleIdToStyleMap) {
+  for (auto const &it : m_state->m_styleIdToStyleMap) {
     if (it.second.m_names[0].empty()) continue;
     auto simpName=libstoff::simplifyString(it.second.m_names[0]);
     if (it.second.m_names[0]==simpName || dupplicatedSimpName.find(simpName)!=dupplicatedSimpName.end()) continue;
@@ -2127,7 +2231,15 @@ StarItemStyle const *StarItemPool::findStyleWithFamily(librevenge::RVNGString co
 {
   if (style.empty())
     return 0;
-  for (int step=0; step<2; ++step) {
+  StarItemPoolInternal::StyleId cacheId(style, family);
+  {
+    std::lock_guard<std::mutex> lock(m_state->m_cacheMutex);
+    auto cIt=m_state->m_findStyleCache.find(cacheId);
+    if (cIt!=m_state->m_findStyleCache.end())
+      return cIt->second;
+  }
+  StarItemStyle const *res=0;
+  for (int step=0; step<2 && !res; ++step) {
     librevenge::RVNGString name(style);
     if (step==1) {
       // hack: try to retrieve the original style, ...
@@ -2139,13 +2251,19 @@ StarItemStyle const *StarItemPool::findStyleWithFamily(librevenge::RVNGString co
     StarItemPoolInternal::StyleId styleId(name, 0);
     auto it=m_state->m_styleIdToStyleMap.lower_bound(styleId);
     while (it!=m_state->m_styleIdToStyleMap.end() && it->first.m_name==name) {
-      if ((it->first.m_family&family)==family)
-        return &it->second;
+      if ((it->first.m_family&family)==family) {
+        res=&it->second;
+        break;
+      }
       ++it;
     }
   }
-  STOFF_DEBUG_MSG(("StarItemPool::findStyleWithFamily: can not find with style %s-%d\n", style.cstr(), family));
-  return 0;
+  if (!res) {
+    STOFF_DEBUG_MSG(("StarItemPool::findStyleWithFamily: can not find with style %s-%d\n", style.cstr(), family));
+  }
+  std::lock_guard<std::mutex> lock(m_state->m_cacheMutex);
+  m_state->m_findStyleCache[cacheId]=res;
+  return res;
 }
 
 void StarItemPool::defineGraphicStyle(STOFFListenerPtr listener, librevenge::RVNGString const &styleName, StarObject &object, std::set<librevenge::RVNGString> &done) const
@@ -2164,23 +2282,47 @@ void StarItemPool::defineGraphicStyle(STOFFListenerPtr listener, librevenge::RVN
     STOFF_DEBUG_MSG(("StarItemPool::defineGraphicStyle: can not find graphic style with name %s", styleName.cstr()));
     return;
   }
+  // the computed style only depends on the pool's document, so it can be reused by the following listeners
+  bool useCache=&object==&m_state->m_document;
+  if (useCache) {
+    STOFFGraphicStyle cached;
+    bool find=false;
+    {
+      std::lock_guard<std::mutex> lock(m_state->m_cacheMutex);
+      auto cIt=m_state->m_graphicStyleCache.find(styleName);
+      if (cIt!=m_state->m_graphicStyleCache.end()) {
+        cached=cIt->second;
+        find=true;
+      }
+    }
+    if (find) {
+      if (!style->m_names[1].empty() && done.find(style->m_names[1])==done.end())
+        defineGraphicStyle(listener, style->m_names[1], object, done);
+      listener->defineStyle(cached);
+      return;
+    }
+  }
   StarState state(this, object);
-  state.m_frame.addTo(state.m_graphic.m_propertyList);
-  state.m_graphic.m_propertyList.insert("style:display-name", styleName);
+  state.m_frame.edit().addTo(state.m_graphic.edit().m_propertyList);
+  state.m_graphic.edit().m_propertyList.insert("style:display-name", styleName);
   if (!style->m_names[1].empty()) {
     if (done.find(style->m_names[1])!=done.end()) {
       STOFF_DEBUG_MSG(("StarItemPool::defineGraphicStyle: oops find a look with %s", style->m_names[1].cstr()));
     }
     else {
       defineGraphicStyle(listener, style->m_names[1], object, done);
-      state.m_graphic.m_propertyList.insert("librevenge:parent-display-name", style->m_names[1]);
+      state.m_graphic.edit().m_propertyList.insert("librevenge:parent-display-name", style->m_names[1]);
     }
   }
-  for (auto it : style->m_itemSet.m_whichToItemMap) {
+  for (auto const &it : style->m_itemSet.m_whichToItemMap) {
     if (it.second && it.second->m_attribute)
       it.second->m_attribute->addTo(state);
   }
-  listener->defineStyle(state.m_graphic);
+  if (useCache) {
+    std::lock_guard<std::mutex> lock(m_state->m_cacheMutex);
+    m_state->m_graphicStyleCache[styleName]=state.m_graphic.get();
+  }
+  listener->defineStyle(state.m_graphic.get());
 }
 
 void StarItemPool::defineParagraphStyle(STOFFListenerPtr listener, librevenge::RVNGString const &styleName, StarObject &object, std::set<librevenge::RVNGString> &done) const
@@ -2199,26 +2341,49 @@ void StarItemPool::defineParagraphStyle(STOFFListenerPtr listener, librevenge::R
     STOFF_DEBUG_MSG(("StarItemPool::defineParagraphStyle: can not find paragraph style with name %s", styleName.cstr()));
     return;
   }
+  bool useCache=&object==&m_state->m_document;
+  if (useCache) {
+    STOFFParagraph cached;
+    bool find=false;
+    {
+      std::lock_guard<std::mutex> lock(m_state->m_cacheMutex);
+      auto cIt=m_state->m_paragraphStyleCache.find(styleName);
+      if (cIt!=m_state->m_paragraphStyleCache.end()) {
+        cached=cIt->second;
+        find=true;
+      }
+    }
+    if (find) {
+      if (!style->m_names[1].empty() && done.find(style->m_names[1])==done.end())
+        defineParagraphStyle(listener, style->m_names[1], object, done);
+      listener->defineStyle(cached);
+      return;
+    }
+  }
   StarState state(this, object);
   if (style->m_outlineLevel>=0 && style->m_outlineLevel<20) {
-    state.m_paragraph.m_outline=true;
-    state.m_paragraph.m_listLevelIndex=style->m_outlineLevel+1;
+    state.m_paragraph.edit().m_outline=true;
+    state.m_paragraph.edit().m_listLevelIndex=style->m_outlineLevel+1;
   }
-  state.m_paragraph.m_propertyList.insert("style:display-name", styleName);
+  state.m_paragraph.edit().m_propertyList.insert("style:display-name", styleName);
   if (!style->m_names[1].empty()) {
     if (done.find(style->m_names[1])!=done.end()) {
       STOFF_DEBUG_MSG(("StarItemPool::defineParagraphStyle: oops find a look with %s", style->m_names[1].cstr()));
     }
     else {
       defineParagraphStyle(listener, style->m_names[1], object, done);
-      state.m_paragraph.m_propertyList.insert("librevenge:parent-display-name", style->m_names[1]);
+      state.m_paragraph.edit().m_propertyList.insert("librevenge:parent-display-name", style->m_names[1]);
     }
   }
-  for (auto it : style->m_itemSet.m_whichToItemMap) {
+  for (auto const &it : style->m_itemSet.m_whichToItemMap) {
     if (it.second && it.second->m_attribute)
       it.second->m_attribute->addTo(state);
   }
-  listener->defineStyle(state.m_paragraph);
+  if (useCache) {
+    std::lock_guard<std::mutex> lock(m_state->m_cacheMutex);
+    m_state->m_paragraphStyleCache[styleName]=state.m_paragraph.get();
+  }
+  listener->defineStyle(state.m_paragraph.get());
 }
 
 void StarItemPool::updateUsingStyles(StarItemSet &itemSet) const
@@ -2226,10 +2391,15 @@ void StarItemPool::updateUsingStyles(StarItemSet &itemSet) const
   auto const *style=findStyleWithFamily(itemSet.m_style, itemSet.m_family);
   if (!style) return;
   auto const &parentItemSet=style->m_itemSet;
-  for (auto it : parentItemSet.m_whichToItemMap) {
-    if (!it.second || itemSet.m_whichToItemMap.find(it.first)!=itemSet.m_whichToItemMap.end())
+  // the style item set is already flattened by updateStyles, so a merge of the two sorted maps suffices
+  auto hint=itemSet.m_whichToItemMap.begin();
+  for (auto const &it : parentItemSet.m_whichToItemMap) {
+    if (!it.second) continue;
+    while (hint!=itemSet.m_whichToItemMap.end() && hint->first<it.first)
+      ++hint;
+    if (hint!=itemSet.m_whichToItemMap.end() && hint->first==it.first)
       continue;
-    itemSet.m_whichToItemMap[it.first]=it.second;
+    hint=itemSet.m_whichToItemMap.insert(hint, it);
   }
 }
 
@@ -50,6 +50,19 @@
 /** Internal: the structures of a StarObject */
 namespace StarObjectInternal
 {
+//! the data read in the document information zone
+struct DocumentInformation {
+  //! constructor
+  DocumentInformation()
+    : m_metaData()
+  {
+  }
+  //! the meta data
+  librevenge::RVNGPropertyList m_metaData;
+  //! the list of user name
+  librevenge::RVNGString m_userMetaNames[4];
+};
+
 //! the state of a StarObject
 struct State {
   //! constructor
@@ -57,6 +70,7 @@ struct State {
     : m_poolList()
     , m_attributeManager(new StarAttributeManager)
     , m_formatManager(new StarFormatManager)
+    , m_documentInformation()
   {
   }
   //! copy constructor
@@ -69,6 +83,8 @@ struct State {
   std::shared_ptr<StarFormatManager> m_formatManager;
   //! the list of user name
   librevenge::RVNGString m_userMetaNames[4];
+  //! the document information which is read by an independent reader (if any)
+  std::shared_ptr<DocumentInformation> m_documentInformation;
 private:
   State operator=(State const &orig) = delete;
 };
@@ -79,6 +95,7 @@ private:
 ////////////////////////////////////////////////////////////
 StarObject::StarObject(char const *passwd, std::shared_ptr<STOFFOLEParser> oleParser, std::shared_ptr<STOFFOLEParser::OleDirectory> directory)
   : m_password(passwd)
+  , m_useThreads(false)
   , m_oleParser(oleParser)
   , m_directory(directory)
   , m_state(new StarObjectInternal::State())
@@ -88,6 +105,7 @@ StarObject::StarObject(char const *passwd, std::shared_ptr<STOFFOLEParser> olePa
 
 StarObject::StarObject(StarObject const &orig, bool duplicateState)
   : m_password(orig.m_password)
+  , m_useThreads(orig.m_useThreads)
   , m_oleParser(orig.m_oleParser)
   , m_directory(orig.m_directory)
   , m_state()
@@ -168,6 +186,11 @@ std::shared_ptr<StarItemPool> StarObject::findItemPool(StarItemPool::Type type,
 }
 
 bool StarObject::parse()
+{
+  return parse(nullptr);
+}
+
+bool StarObject::parse(std::vector<std::function<void()> > *independentReaders)
 {
   if (!m_directory) {
     STOFF_DEBUG_MSG(("StarObject::parse: can not find directory\n"));
@@ -204,12 +227,29 @@ bool StarObject::parse()
     }
     if (base=="SfxPreview") {
       content.setParsed(true);
-      readSfxPreview(ole, name);
+      auto reader=[this, ole, name]() {
+        readSfxPreview(ole, name);
+      };
+      if (independentReaders)
+        independentReaders->push_back(reader);
+      else
+        reader();
       continue;
     }
     if (base=="SfxDocumentInfo") {
       content.setParsed(true);
-      readSfxDocumentInformation(ole, name);
+      // the reader does not modify the object, the result is merged in mergeIndependentData
+      std::shared_ptr<StarObjectInternal::DocumentInformation> info(new StarObjectInternal::DocumentInformation);
+      m_state->m_documentInformation=info;
+      auto reader=[ole, name, info]() {
+        readSfxDocumentInformation(ole, name, *info);
+      };
+      if (independentReaders)
+        independentReaders->push_back(reader);
+      else {
+        reader();
+        mergeIndependentData();
+      }
       continue;
     }
     libstoff::DebugFile asciiFile(ole);
@@ -226,6 +266,20 @@ bool StarObject::parse()
   return true;
 }
 
+void StarObject::mergeIndependentData()
+{
+  if (!m_state->m_documentInformation) return;
+  auto const &info=*m_state->m_documentInformation;
+  librevenge::RVNGPropertyList::Iter i(info.m_metaData);
+  for (i.rewind(); i.next();)
+    m_metaData.insert(i.key(), i()->getStr());
+  for (int j=0; j<4; ++j) {
+    if (!info.m_userMetaNames[j].empty())
+      m_state->m_userMetaNames[j]=info.m_userMetaNames[j];
+  }
+  m_state->m_documentInformation.reset();
+}
+
 bool StarObject::readItemSet(StarZone &zone, std::vector<STOFFVec2i> const &/*limits*/, long lastPos,
                              StarItemSet &itemSet, StarItemPool *pool, bool isDirect)
 {
@@ -610,7 +664,18 @@ bool StarObject::readPersistData(StarZone &zone, long lastPos, bool inPersistEle
   return true;
 }
 
-bool StarObject::readSfxDocumentInformation(STOFFInputStreamPtr input, std::string const &name)
+bool StarObject::readSfxDocumentInformation(STOFFInputStreamPtr input, std::string const &name, librevenge::RVNGPropertyList &metaData)
+{
+  StarObjectInternal::DocumentInformation info;
+  if (!readSfxDocumentInformation(input, name, info))
+    return false;
+  librevenge::RVNGPropertyList::Iter i(info.m_metaData);
+  for (i.rewind(); i.next();)
+    metaData.insert(i.key(), i()->getStr());
+  return true;
+}
+
+bool StarObject::readSfxDocumentInformation(STOFFInputStreamPtr input, std::string const &name, StarObjectInternal::DocumentInformation &info)
 {
   StarZone zone(input, name, "SfxDocInfo", 0); // no password
   libstoff::DebugFile &ascii=zone.ascii();
@@ -690,18 +755,18 @@ bool StarObject::readSfxDocumentInformation(STOFFInputStreamPtr input, std::stri
         "librevenge:template-name", "librevenge:template-filename"
       };
       if ((i%2)==1 && i>=7 && i<=13)
-        m_state->m_userMetaNames[(i-7)/2]=attrib;
+        info.m_userMetaNames[(i-7)/2]=attrib;
       if (attrib.empty() || std::string(attribNames[i]).empty())
         prevAttrib=attrib;
       else if (std::string(attribNames[i])=="user") {
         if (!prevAttrib.empty()) {
           librevenge::RVNGString userMeta("librevenge:");
           userMeta.append(prevAttrib);
-          m_metaData.insert(userMeta.cstr(), attrib);
+          info.m_metaData.insert(userMeta.cstr(), attrib);
         }
       }
       else
-        m_metaData.insert(attribNames[i], attrib);
+        info.m_metaData.insert(attribNames[i], attrib);
     }
     else {
       STOFF_DEBUG_MSG(("StarObject::readSfxDocumentInformation: can not convert a string\n"));
@@ -716,7 +781,7 @@ bool StarObject::readSfxDocumentInformation(STOFFInputStreamPtr input, std::stri
       std::string dateTime;
       if (date && libstoff::convertToDateTime(date,time, dateTime)) {
         static char const *(attribNames[])= { "meta:creation-date", "dc:date", "meta:print-date" };
-        m_metaData.insert(attribNames[i], dateTime.c_str());
+        info.m_metaData.insert(attribNames[i], dateTime.c_str());
       }
     }
     ascii.addPos(pos);
@@ -922,7 +987,7 @@ bool StarObject::readStarFrameworkConfigItem(STOFFEntry &entry, STOFFInputStream
   return true;
 }
 
-bool StarObject::readSfxPreview(STOFFInputStreamPtr input, std::string const &name)
+bool StarObject::readSfxPreview(STOFFInputStreamPtr input, std::string const &name) const
 {
   StarZone zone(input, name, "SfxPreview", m_password);
   libstoff::DebugFile &ascii=zone.ascii();
@@ -38,6 +38,7 @@
 #ifndef STAR_OBJECT
 #  define STAR_OBJECT
 
+#include <functional>
 #include <vector>
 #include <stack>
 #include <libstaroffice/STOFFDocument.hxx>
@@ -49,6 +50,7 @@
 
 namespace StarObjectInternal
 {
+struct DocumentInformation;
 struct State;
 }
 
@@ -75,6 +77,15 @@ public:
 
   //! try to parse data
   bool parse();
+  /** try to parse data.
+
+      If independentReaders is set, the zones which do not depend on the other zones (the preview
+      and the document information) are not read, their readers are added to independentReaders.
+      These readers can be called in other threads, then mergeIndependentData must be called.
+   */
+  bool parse(std::vector<std::function<void()> > *independentReaders);
+  //! merges the data read by the independent readers in the document
+  void mergeIndependentData();
   //! returns the document kind
   STOFFDocument::Kind getDocumentKind() const;
   //! returns the document password (the password given by the user)
@@ -82,6 +93,16 @@ public:
   {
     return m_password;
   }
+  //! returns true if the independent zones can be read in several threads
+  bool useThreads() const
+  {
+    return m_useThreads;
+  }
+  //! sets the threads flag
+  void setUseThreads(bool useThreads)
+  {
+    m_useThreads=useThreads;
+  }
   //! returns the object directory
   std::shared_ptr<STOFFOLEParser::OleDirectory> getOLEDirectory()
   {
@@ -110,6 +131,8 @@ public:
   //! returns the current all/inside pool
   std::shared_ptr<StarItemPool> getCurrentPool(bool onlyInside=true);
 
+  //! try to read the document information : "SfxDocumentInformation" and to store its data in metaData
+  static bool readSfxDocumentInformation(STOFFInputStreamPtr input, std::string const &name, librevenge::RVNGPropertyList &metaData);
   //! try to read persist data
   bool readPersistData(StarZone &zone, long endPos, bool inPersistElements=false);
   //! try to read a spreadshet style zone: SfxStyleSheets
@@ -121,9 +144,9 @@ protected:
   //!  the "persist elements" small ole: the list of object
   bool readPersistElements(STOFFInputStreamPtr input, std::string const &name);
   //! try to read the document information : "SfxDocumentInformation"
-  bool readSfxDocumentInformation(STOFFInputStreamPtr input, std::string const &name);
+  static bool readSfxDocumentInformation(STOFFInputStreamPtr input, std::string const &name, StarObjectInternal::DocumentInformation &info);
   //! try to read the preview : "SfxPreview"
-  bool readSfxPreview(STOFFInputStreamPtr input, std::string const &name);
+  bool readSfxPreview(STOFFInputStreamPtr input, std::string const &name) const;
   //! try to read the windows information : "SfxWindows"
   bool readSfxWindows(STOFFInputStreamPtr input, libstoff::DebugFile &ascii);
   //! try to read the "Star Framework Config File"
@@ -139,6 +162,8 @@ protected:
   StarObject(StarObject const &orig, bool duplicateState);
   //! the document password
   char const *m_password;
+  //! a flag to know if the independent zones can be read in several threads
+  bool m_useThreads;
   //! the ole parser
   std::shared_ptr<STOFFOLEParser> m_oleParser;
   //! the directory
@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <algorithm>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -54,26 +55,11 @@
 
 #include "StarObjectChart.hxx"
 
-/** Internal: the structures of a StarObjectChart */
-namespace StarObjectChartInternal
-{
-////////////////////////////////////////
-//! Internal: the state of a StarObjectChart
-struct State {
-  //! constructor
-  State()
-  {
-  }
-};
-
-}
-
 ////////////////////////////////////////////////////////////
 // constructor/destructor, ...
 ////////////////////////////////////////////////////////////
 StarObjectChart::StarObjectChart(StarObject const &orig, bool duplicateState)
   : StarObject(orig, duplicateState)
-  , m_chartState(new StarObjectChartInternal::State)
 {
 }
 
@@ -879,19 +865,33 @@ bool StarObjectChart::readSCHMemChart(StarZone &zone)
   ascFile.addPos(pos);
   ascFile.addNote(f.str().c_str());
   if (nCol && nRow) {
+    // the values are only used to debug, so read them in one call or skip them
+    pos=input->tell();
+    long endPos=pos+8*long(nCol)*long(nRow);
+    if (endPos>lastPos || !input->checkPosition(endPos)) {
+      STOFF_DEBUG_MSG(("StarObjectChart::readSCHMemChart: can not read the values\n"));
+      ascFile.addPos(pos);
+      ascFile.addNote("SCHMemChart-val:###");
+      zone.closeSCHHeader("SCHMemChart");
+      return true;
+    }
+#ifdef DEBUG_WITH_FILES
+    std::vector<double> values(size_t(nCol)*size_t(nRow));
+    if (!input->readDoublesReverted8(values.data(), values.size())) {
+      STOFF_DEBUG_MSG(("StarObjectChart::readSCHMemChart: can not read some values\n"));
+      std::fill(values.begin(), values.end(), 0);
+    }
     for (int c=0; c < int(nCol); ++c) {
-      pos=input->tell();
       f.str("");
       f << "SCHMemChart-col" << c << ":val=[";
-      for (int r=0; r < int(nRow); ++r) {
-        double val;
-        *input>>val;
-        f << val << ",";
-      }
+      for (size_t r=0; r < size_t(nRow); ++r)
+        f << values[size_t(c)*size_t(nRow)+r] << ",";
       f << "],";
-      ascFile.addPos(pos);
+      ascFile.addPos(pos+8*long(c)*long(nRow));
       ascFile.addNote(f.str().c_str());
     }
+#endif
+    input->seek(endPos, librevenge::RVNG_SEEK_SET);
   }
   pos=input->tell();
   f.str("");
@@ -44,11 +44,6 @@
 #include "libstaroffice_internal.hxx"
 #include "StarObject.hxx"
 
-namespace StarObjectChartInternal
-{
-struct State;
-}
-
 class StarZone;
 
 /** \brief the main class to read a StarOffice chart
@@ -79,9 +74,6 @@ protected:
   bool readSCHAttributes(StarZone &zone);
   //! try to read the memchart data
   bool readSCHMemChart(StarZone &zone);
-
-  //! the state
-  std::shared_ptr<StarObjectChartInternal::State> m_chartState;
 };
 #endif
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -120,6 +120,20 @@ bool StarObjectDraw::sendPages(STOFFGraphicListenerPtr listener)
   return m_drawState->m_model->sendPages(listener);
 }
 
+bool StarObjectDraw::sendPageWithMaster(int page, STOFFGraphicListenerPtr listener)
+{
+  if (!m_drawState->m_model)
+    return false;
+  return m_drawState->m_model->sendPageWithMaster(page, listener);
+}
+
+bool StarObjectDraw::extractText(STOFFTextExtractor &extractor)
+{
+  if (!m_drawState->m_model)
+    return false;
+  return m_drawState->m_model->extractText(extractor);
+}
+
 ////////////////////////////////////////////////////////////
 // main zone
 ////////////////////////////////////////////////////////////
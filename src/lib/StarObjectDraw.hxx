@@ -74,6 +74,10 @@ public:
   bool sendPages(STOFFGraphicListenerPtr listener);
   //! try to send the master pages
   bool sendMasterPages(STOFFGraphicListenerPtr listener);
+  //! try to send a page and its master page to a listener which contains only this page, see StarObjectModel::sendPageWithMaster
+  bool sendPageWithMaster(int page, STOFFGraphicListenerPtr listener);
+  //! try to send only the text of the pages to a text extractor
+  bool extractText(STOFFTextExtractor &extractor);
 
 protected:
   //! try to read a spreadsheet zone: StarDrawDocument .sdd
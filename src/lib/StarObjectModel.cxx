@@ -402,26 +402,48 @@ bool StarObjectModel::sendMasterPages(STOFFGraphicListenerPtr listener)
     STOFF_DEBUG_MSG(("StarObjectModel::sendMasterPages: can not find the listener\n"));
     return false;
   }
-  int numMasters=int(m_modelState->m_masterPageList.size());
-  for (auto id : m_modelState->m_masterPageToSendSet) {
-    if (id<0 || id>=numMasters || !m_modelState->m_masterPageList[size_t(id)]) {
-      STOFF_DEBUG_MSG(("StarObjectModel::sendMasterPages: can not find master page %d\n", id));
-      continue;
-    }
-    auto const &page=*m_modelState->m_masterPageList[size_t(id)];
-    STOFFPageSpan ps;
-    page.updatePageSpan(ps);
-    librevenge::RVNGString masterName;
-    masterName.sprintf("Master%d", id);
-    ps.m_propertiesList[0].insert("librevenge:master-page-name", masterName);
-    listener->openMasterPage(ps);
-    sendPage(id, listener, true);
-    listener->closeMasterPage();
+  for (auto id : m_modelState->m_masterPageToSendSet)
+    sendMasterPage(id, listener);
+  return true;
+}
+
+bool StarObjectModel::sendMasterPage(int id, STOFFGraphicListenerPtr listener)
+{
+  if (id<0 || id>=int(m_modelState->m_masterPageList.size()) || !m_modelState->m_masterPageList[size_t(id)]) {
+    STOFF_DEBUG_MSG(("StarObjectModel::sendMasterPage: can not find master page %d\n", id));
+    return false;
   }
+  auto const &page=*m_modelState->m_masterPageList[size_t(id)];
+  STOFFPageSpan ps;
+  page.updatePageSpan(ps);
+  librevenge::RVNGString masterName;
+  masterName.sprintf("Master%d", id);
+  ps.m_propertiesList[0].insert("librevenge:master-page-name", masterName);
+  listener->openMasterPage(ps);
+  sendPage(id, listener, true);
+  listener->closeMasterPage();
   return true;
 }
 
-bool StarObjectModel::sendPage(int pageId, STOFFListenerPtr listener, bool masterPage)
+bool StarObjectModel::sendPageWithMaster(int page, STOFFGraphicListenerPtr listener)
+{
+  if (!listener) {
+    STOFF_DEBUG_MSG(("StarObjectModel::sendPageWithMaster: can not find the listener\n"));
+    return false;
+  }
+  if (page<0 || page>=int(m_modelState->m_pageToSendList.size())) {
+    STOFF_DEBUG_MSG(("StarObjectModel::sendPageWithMaster: can not find page %d\n", page));
+    return false;
+  }
+  int pageId=m_modelState->m_pageToSendList[size_t(page)];
+  auto const &pageData=m_modelState->m_pageList[size_t(pageId)];
+  int masterId=pageData ? pageData->getMasterPageId() : -1;
+  if (m_modelState->m_masterPageToSendSet.find(masterId)!=m_modelState->m_masterPageToSendSet.end())
+    sendMasterPage(masterId, listener);
+  return sendPage(pageId, listener, false, 1);
+}
+
+bool StarObjectModel::sendPage(int pageId, STOFFListenerPtr listener, bool masterPage, int pageNumber)
 {
   if (!listener) {
     STOFF_DEBUG_MSG(("StarObjectModel::sendPage: can not find the listener\n"));
@@ -438,7 +460,7 @@ bool StarObjectModel::sendPage(int pageId, STOFFListenerPtr listener, bool maste
   StarObjectModelInternal::Page &page=*pageList[size_t(pageId)];
   STOFFPosition pos;
   pos.m_anchorTo=STOFFPosition::Page;
-  if (!masterPage) pos.m_propertyList.insert("text:anchor-page-number", pageId+1);
+  if (!masterPage) pos.m_propertyList.insert("text:anchor-page-number", pageNumber>=0 ? pageNumber : pageId+1);
   for (auto pag : page.m_objectList) {
     if (pag)
       pag->send(listener, pos, *this, masterPage);
@@ -446,6 +468,24 @@ bool StarObjectModel::sendPage(int pageId, STOFFListenerPtr listener, bool maste
   return true;
 }
 
+bool StarObjectModel::extractText(STOFFTextExtractor &extractor)
+{
+  for (size_t i=0; i<m_modelState->m_pageList.size(); ++i)
+    extractPageText(int(i), extractor);
+  return true;
+}
+
+bool StarObjectModel::extractPageText(int pageId, STOFFTextExtractor &extractor)
+{
+  if (pageId<0 || pageId>=int(m_modelState->m_pageList.size()) || !m_modelState->m_pageList[size_t(pageId)])
+    return false;
+  for (auto obj : m_modelState->m_pageList[size_t(pageId)]->m_objectList) {
+    if (obj)
+      obj->extractText(extractor);
+  }
+  return true;
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
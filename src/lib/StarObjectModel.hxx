@@ -75,11 +75,22 @@ public:
   bool sendMasterPages(STOFFGraphicListenerPtr listener);
   //! try to send the different page
   bool sendPages(STOFFListenerPtr listener);
-  //! try to send a page content
-  bool sendPage(int pageId, STOFFListenerPtr listener, bool masterPage=false);
+  /** try to send the page-th page (and its master page) to a listener which contains only this page.
+
+      \note can be called simultaneously in different threads with different listeners once updatePageSpans is called */
+  bool sendPageWithMaster(int page, STOFFGraphicListenerPtr listener);
+  //! try to send a page content, pageNumber is the page number in the final document(if -1, pageId+1 is used)
+  bool sendPage(int pageId, STOFFListenerPtr listener, bool masterPage=false, int pageNumber=-1);
+  //! try to send the text of all the pages(but not the master pages) to a text extractor
+  bool extractText(STOFFTextExtractor &extractor);
+  //! try to send the text of a page to a text extractor
+  bool extractPageText(int pageId, STOFFTextExtractor &extractor);
   //! small operator<< to print the content of the model
   friend std::ostream &operator<<(std::ostream &o, StarObjectModel const &model);
 protected:
+  //! try to send a master page
+  bool sendMasterPage(int id, STOFFGraphicListenerPtr listener);
+
   //
   // low level
   //
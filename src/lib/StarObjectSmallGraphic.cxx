@@ -182,6 +182,18 @@ public:
     }
     return true;
   }
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor)
+  {
+    if (m_textZone)
+      m_textZone->extractText(extractor);
+    else {
+      for (auto const &z : m_zones) {
+        if (z.m_text)
+          z.m_text->extractText(extractor);
+      }
+    }
+  }
   //! the version
   int m_version;
   //! the list of zones: version<=3
@@ -267,6 +279,10 @@ public:
     }
     return false;
   }
+  //! try to send only the text to a text extractor
+  virtual void extractText(STOFFTextExtractor &/*extractor*/)
+  {
+  }
   //! the type
   int m_identifier;
 };
@@ -444,14 +460,14 @@ public:
   //! try to update the graphic style
   void updateStyle(StarState &state, STOFFListenerPtr /*listener*/) const
   {
-    state.m_frame.addTo(state.m_graphic.m_propertyList);
+    state.m_frame.edit().addTo(state.m_graphic.edit().m_propertyList);
     if (m_flags[0] && m_flags[1])
-      state.m_graphic.m_propertyList.insert("style:protect", "position size");
+      state.m_graphic.edit().m_propertyList.insert("style:protect", "position size");
     else if (m_flags[0])
-      state.m_graphic.m_propertyList.insert("style:protect", "position");
+      state.m_graphic.edit().m_propertyList.insert("style:protect", "position");
     else if (m_flags[1])
-      state.m_graphic.m_propertyList.insert("style:protect", "size");
-    state.m_graphic.m_propertyList.insert("style:print-content", !m_flags[2]);
+      state.m_graphic.edit().m_propertyList.insert("style:protect", "size");
+    state.m_graphic.edit().m_propertyList.insert("style:print-content", !m_flags[2]);
     // todo noVisible as master ie hide in master
   }
   //! basic print function
@@ -526,7 +542,7 @@ public:
       auto const *mStyle=state.m_global->m_pool->findStyleWithFamily(m_sheetStyle, StarItemStyle::F_Paragraph);
       if (mStyle && !mStyle->m_names[0].empty()) {
         if (listener) state.m_global->m_pool->defineGraphicStyle(listener, mStyle->m_names[0], state.m_global->m_object);
-        state.m_graphic.m_propertyList.insert("librevenge:parent-display-name", mStyle->m_names[0]);
+        state.m_graphic.edit().m_propertyList.insert("librevenge:parent-display-name", mStyle->m_names[0]);
       }
       else if (mStyle) {
         for (auto it : mStyle->m_itemSet.m_whichToItemMap) {
@@ -604,6 +620,14 @@ public:
     listener->closeGroup();
     return true;
   }
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor) final
+  {
+    for (auto &child : m_child) {
+      if (child)
+        child->extractText(extractor);
+    }
+  }
   //! print object data
   friend std::ostream &operator<<(std::ostream &o, SdrGraphicGroup const &graph)
   {
@@ -692,19 +716,25 @@ public:
     auto pool=getPool(object);
     StarState state(pool.get(), object);
     updateStyle(state, listener);
-    // if (!state.m_graphic.m_hasBackground) state.m_graphic.m_propertyList.insert("draw:fill", "none"); checkme
-    state.m_graphic.m_propertyList.insert("draw:fill", "none");
-    state.m_graphic.m_propertyList.insert("draw:shadow", "hidden"); // the text is not shadowed
+    // if (!state.m_graphic->m_hasBackground) state.m_graphic->m_propertyList.insert("draw:fill", "none"); checkme
+    state.m_graphic.edit().m_propertyList.insert("draw:fill", "none");
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow", "hidden"); // the text is not shadowed
     if (m_textDrehWink) {
       STOFFVec2f orig=libstoff::convertMiniMToPointVect(box[0]);
-      state.m_graphic.m_propertyList.insert("librevenge:rotate-cx", orig[0], librevenge::RVNG_POINT);
-      state.m_graphic.m_propertyList.insert("librevenge:rotate-cy", orig[1], librevenge::RVNG_POINT);
-      state.m_graphic.m_propertyList.insert("librevenge:rotate", -m_textDrehWink/100., librevenge::RVNG_GENERIC);
+      state.m_graphic.edit().m_propertyList.insert("librevenge:rotate-cx", orig[0], librevenge::RVNG_POINT);
+      state.m_graphic.edit().m_propertyList.insert("librevenge:rotate-cy", orig[1], librevenge::RVNG_POINT);
+      state.m_graphic.edit().m_propertyList.insert("librevenge:rotate", -m_textDrehWink/100., librevenge::RVNG_GENERIC);
     }
     std::shared_ptr<SubDocument> doc(new SubDocument(m_outlinerParaObject));
-    listener->insertTextBox(position, doc, state.m_graphic);
+    listener->insertTextBox(position, doc, state.m_graphic.get());
     return true;
   }
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor) override
+  {
+    if (m_outlinerParaObject)
+      m_outlinerParaObject->extractText(extractor);
+  }
   //! print object data
   friend std::ostream &operator<<(std::ostream &o, SdrGraphicText const &graph)
   {
@@ -765,7 +795,7 @@ public:
       std::shared_ptr<StarItemPool> pool=getPool(object);
       StarState state(pool.get(), object);
       updateStyle(state, listener);
-      listener->insertShape(shape, state.m_graphic, pos);
+      listener->insertShape(shape, state.m_graphic.get(), pos);
       if (m_outlinerParaObject)
         sendTextZone(listener, object);
     }
@@ -850,7 +880,7 @@ public:
     auto pool=getPool(object);
     StarState state(pool.get(), object);
     updateStyle(state, listener);
-    listener->insertShape(shape, state.m_graphic, pos);
+    listener->insertShape(shape, state.m_graphic.get(), pos);
     return true;
   }
   //! a polygon
@@ -910,7 +940,7 @@ public:
     auto pool=getPool(object);
     StarState state(pool.get(), object);
     updateStyle(state, listener);
-    listener->insertShape(shape, state.m_graphic, pos);
+    listener->insertShape(shape, state.m_graphic.get(), pos);
     if (m_outlinerParaObject)
       sendTextZone(listener, object);
     return true;
@@ -1036,7 +1066,7 @@ public:
     auto pool=getPool(object);
     StarState state(pool.get(), object);
     updateStyle(state, listener);
-    listener->insertShape(shape, state.m_graphic, pos);
+    listener->insertShape(shape, state.m_graphic.get(), pos);
     return true;
   }
   //! the edge polygon
@@ -1105,10 +1135,10 @@ public:
       // CHECKME: we need probably correct the filename, transform ":" in "/", ...
       STOFFEmbeddedObject link;
       link.m_filenameLink=m_graphNames[1];
-      listener->insertPicture(position, link, state.m_graphic);
+      listener->insertPicture(position, link, state.m_graphic.get());
     }
     else
-      listener->insertPicture(position, m_graphic->m_object, state.m_graphic);
+      listener->insertPicture(position, m_graphic->m_object, state.m_graphic.get());
 
     return true;
   }
@@ -1200,7 +1230,7 @@ public:
     }
     shape.m_propertyList.insert("svg:points", vect);
     updateTransformProperties(shape.m_propertyList);
-    listener->insertShape(shape, state.m_graphic, pos);
+    listener->insertShape(shape, state.m_graphic.get(), pos);
     return true;
   }
   //! try to update the style
@@ -1264,6 +1294,8 @@ public:
       STOFF_DEBUG_MSG(("StarObjectSmallGraphicInternal::SdrGraphicOLE::send: can not send a shape\n"));
       return false;
     }
+    if (listener->skipPictures())
+      return true;
     STOFFEmbeddedObject localPicture;
     if (!m_oleNames[0].empty() && m_oleParser)
     {
@@ -1273,17 +1305,7 @@ public:
       }
     }
     if (m_graphic && !m_graphic->m_object.isEmpty())
-    {
-      size_t numTypes=m_graphic->m_object.m_typeList.size();
-      for (size_t i=0; i<m_graphic->m_object.m_dataList.size(); ++i) {
-        if (m_graphic->m_object.m_dataList[i].empty())
-          continue;
-        if (i<numTypes)
-          localPicture.add(m_graphic->m_object.m_dataList[i], m_graphic->m_object.m_typeList[i]);
-        else
-          localPicture.add(m_graphic->m_object.m_dataList[i]);
-      }
-    }
+      localPicture.add(m_graphic->m_object);
     if (localPicture.isEmpty())
     {
       STOFF_DEBUG_MSG(("StarObjectSmallGraphicInternal::SdrGraphicOLE::send: sorry, can not find some graphic representation\n"));
@@ -1296,7 +1318,7 @@ public:
     auto pool=getPool(object);
     StarState state(pool.get(), object);
     updateStyle(state, listener);
-    listener->insertPicture(position, localPicture, state.m_graphic);
+    listener->insertPicture(position, localPicture, state.m_graphic.get());
 
     return true;
   }
@@ -1434,7 +1456,7 @@ bool SdrGraphicPath::send(STOFFListenerPtr listener, STOFFPosition const &pos, S
       }
       shape.m_propertyList.insert("svg:points", vect);
       updateTransformProperties(shape.m_propertyList);
-      listener->insertShape(shape, state.m_graphic, pos);
+      listener->insertShape(shape, state.m_graphic.get(), pos);
       if (m_outlinerParaObject)
         sendTextZone(listener, object);
       return true;
@@ -1483,12 +1505,12 @@ bool SdrGraphicPath::send(STOFFListenerPtr listener, STOFFPosition const &pos, S
   else {
     shape.m_command=STOFFGraphicShape::C_Path;
     librevenge::RVNGPropertyListVector path;
-    for (auto const poly : m_pathPolygons)
+    for (auto const &poly : m_pathPolygons)
       poly.addToPath(path, isClosed);
     shape.m_propertyList.insert("svg:d", path);
   }
   updateTransformProperties(shape.m_propertyList);
-  listener->insertShape(shape, state.m_graphic, pos);
+  listener->insertShape(shape, state.m_graphic.get(), pos);
   if (m_outlinerParaObject)
     sendTextZone(listener, object);
   return true;
@@ -1668,6 +1690,14 @@ bool StarObjectSmallGraphic::send(STOFFListenerPtr listener, STOFFPosition const
   return m_graphicState->m_graphic->send(listener, pos, object, inMasterPage);
 }
 
+bool StarObjectSmallGraphic::extractText(STOFFTextExtractor &extractor)
+{
+  if (!m_graphicState->m_graphic)
+    return false;
+  m_graphicState->m_graphic->extractText(extractor);
+  return true;
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -2345,18 +2375,14 @@ bool StarObjectSmallGraphic::readSVDRObjectGraph(StarZone &zone, StarObjectSmall
     }
     else {
       if (smallGraphic->m_object.isEmpty()) {
-        long endPictPos=input->tell();
         // try to recover can recover here the unknown graphic
-        input->seek(begPictPos, librevenge::RVNG_SEEK_SET);
-        librevenge::RVNGBinaryData data;
-        if (!input->readDataBlock(endPictPos-begPictPos,data)) {
+        if (input->tell()<=begPictPos) {
           STOFF_DEBUG_MSG(("StarObjectSmallGraphic::readSVDRObjectGraph: can not retrieve unknown data\n"));
         }
         else {
-          smallGraphic->m_object.add(data, "image/pct");
+          smallGraphic->m_object.addLazy(input, begPictPos, input->tell(), "image/pct");
           graphic.m_graphic=smallGraphic;
         }
-        input->seek(endPictPos, librevenge::RVNG_SEEK_SET);
       }
       else
         graphic.m_graphic=smallGraphic;
@@ -2630,16 +2656,15 @@ bool StarObjectSmallGraphic::readSVDRObjectOLE(StarZone &zone, StarObjectSmallGr
       long beginPos=input->tell();
       if (!smallGraphic->read(zone, lastPos) || input->tell()>lastPos || smallGraphic->m_object.isEmpty()) {
         // try to recover can recover here the unknown graphic
-        input->seek(beginPos, librevenge::RVNG_SEEK_SET);
-        librevenge::RVNGBinaryData data;
-        if (!input->readDataBlock(lastPos-beginPos,data)) {
+        if (beginPos>=lastPos) {
           STOFF_DEBUG_MSG(("StarObjectSmallGraphic::readSVDRObjectOLE: can not retrieve unknown data\n"));
           f << "###graphic";
           ok=false;
         }
         else {
-          smallGraphic->m_object.add(data, "image/pct");
+          smallGraphic->m_object.addLazy(input, beginPos, lastPos, "image/pct");
           graphic.m_graphic=smallGraphic;
+          input->seek(lastPos, librevenge::RVNG_SEEK_SET);
         }
       }
       else
@@ -2696,11 +2721,10 @@ bool StarObjectSmallGraphic::readSVDRObjectPath(StarZone &zone, StarObjectSmallG
         break;
       }
       graphic.m_pathPolygons.push_back(StarGraphicStruct::StarPolygon());
-      auto &polygon=graphic.m_pathPolygons.back();
-      for (int pt=0; pt<int(n); ++pt) {
-        int dim[2];
-        for (int i=0; i<2; ++i) dim[i]=int(input->readLong(4));
-        polygon.m_points.push_back(StarGraphicStruct::StarPolygon::Point(STOFFVec2i(dim[0],dim[1])));
+      if (!graphic.m_pathPolygons.back().readPoints(zone, size_t(n), false)) {
+        f << "###points,";
+        ok=false;
+        break;
       }
     }
   }
@@ -2724,15 +2748,11 @@ bool StarObjectSmallGraphic::readSVDRObjectPath(StarZone &zone, StarObjectSmallG
         break;
       }
       graphic.m_pathPolygons.push_back(StarGraphicStruct::StarPolygon());
-      auto &polygon=graphic.m_pathPolygons.back();
-      polygon.m_points.resize(size_t(n));
-      for (size_t pt=0; pt<size_t(n); ++pt) {
-        int dim[2];
-        for (int i=0; i<2; ++i) dim[i]=int(input->readLong(4));
-        polygon.m_points[pt].m_point=STOFFVec2i(dim[0],dim[1]);
+      if (!graphic.m_pathPolygons.back().readPoints(zone, size_t(n), true)) {
+        f << "###points,";
+        ok=false;
+        break;
       }
-      for (size_t pt=0; pt<size_t(n); ++pt)
-        polygon.m_points[pt].m_flags=int(input->readULong(1));
     }
     if (recOpened) {
       if (input->tell()!=zone.getRecordLastPosition()) {
@@ -84,6 +84,8 @@ public:
   bool readSdrObject(StarZone &zone);
   //! try to send a object to the listener
   bool send(STOFFListenerPtr listener, STOFFPosition const &pos, StarObject &object, bool inPageMaster=false);
+  //! try to send only the text of the object to a text extractor
+  bool extractText(STOFFTextExtractor &extractor);
   //! small operator<< to print the content of the small graphic object
   friend std::ostream &operator<<(std::ostream &o, StarObjectSmallGraphic const &graphic);
 
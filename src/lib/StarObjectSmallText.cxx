@@ -42,6 +42,7 @@
 #include "STOFFFont.hxx"
 #include "STOFFListener.hxx"
 #include "STOFFParagraph.hxx"
+#include "STOFFTextExtractor.hxx"
 
 #include "StarAttribute.hxx"
 #include "StarObject.hxx"
@@ -116,7 +117,7 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
     }
   }
   editState.m_paragraph=mainState.m_paragraph;
-  if (level>=0) editState.m_paragraph.m_listLevelIndex=level;
+  if (level>=0) editState.m_paragraph.edit().m_listLevelIndex=level;
   editState.m_font=mainState.m_font;
   for (auto it : m_itemSet.m_whichToItemMap) {
     if (!it.second || !it.second->m_attribute) continue;
@@ -125,9 +126,9 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
 #if 0
   std::cerr << "ItemSet:" << m_itemSet.printChild() << "\n";
 #endif
-  STOFFFont mainFont=editState.m_font; // save font
+  STOFFFont mainFont=editState.m_font.get(); // save font
   listener->setFont(mainFont);
-  listener->setParagraph(editState.m_paragraph);
+  listener->setParagraph(editState.m_paragraph.get());
 
   std::set<size_t> modPosSet;
   size_t numFonts=m_charItemList.size();
@@ -149,9 +150,8 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
       fontChange=true;
     }
     if (fontChange) {
-      STOFFFont &font=editState.m_font;
       editState.reinitializeLineData();
-      font=mainFont;
+      editState.m_font=mainFont;
       for (size_t f=0; f<numFonts; ++f) {
         if (m_charLimitList[f][0]>int(srcPos) || m_charLimitList[f][1]<=int(srcPos))
           continue;
@@ -164,14 +164,25 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
         STOFF_DEBUG_MSG(("StarObjectSmallTextInternal::Paragraph::send: sorry, sending content/field/footnote/refMark/link is not implemented\n"));
         first=false;
       }
-      listener->setFont(font);
+      listener->setFont(editState.m_font.get());
     }
     if (m_text[c]==0x9)
       listener->insertTab();
     else if (m_text[c]==0xa)
       listener->insertEOL(true);
-    else
-      listener->insertUnicode(m_text[c]);
+    else {
+      // send the next characters with the same font in one run
+      size_t end=c+1;
+      for (; end<m_text.size(); ++end) {
+        if (m_text[end]==0x9 || m_text[end]==0xa)
+          break;
+        size_t endSrcPos=end<m_textSourcePosition.size() ? m_textSourcePosition[end] : 10000;
+        if (posSetIt!=modPosSet.end() && *posSetIt <= endSrcPos)
+          break;
+      }
+      listener->insertUnicodeRun(&m_text[c], end-c);
+      c=end-1;
+    }
   }
   return true;
 }
@@ -223,6 +234,13 @@ bool StarObjectSmallText::send(std::shared_ptr<STOFFListener> listener, int leve
   return true;
 }
 
+bool StarObjectSmallText::extractText(STOFFTextExtractor &extractor)
+{
+  for (auto const &para : m_textState->m_paragraphList)
+    extractor.insertParagraph(para.m_text);
+  return true;
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
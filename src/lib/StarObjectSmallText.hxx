@@ -68,6 +68,8 @@ public:
 
   //! try to send a small text zone
   bool send(std::shared_ptr<STOFFListener> listener, int level=-1);
+  //! try to send only the text to a text extractor
+  bool extractText(STOFFTextExtractor &extractor);
 protected:
   //
   // low level
@@ -31,12 +31,16 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
+#include <exception>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 
 #include <librevenge/librevenge.h>
 
@@ -57,9 +61,11 @@
 #include "STOFFGraphicStyle.hxx"
 #include "STOFFOLEParser.hxx"
 #include "STOFFPageSpan.hxx"
+#include "STOFFStringStream.hxx"
 #include "STOFFSubDocument.hxx"
 #include "STOFFSpreadsheetListener.hxx"
 #include "STOFFTable.hxx"
+#include "STOFFTextExtractor.hxx"
 
 #include "StarFormatManager.hxx"
 
@@ -270,6 +276,35 @@ public:
   }
   //! destructor
   ~Cell();
+  /** returns true if the two cells can be sent as one repeated cell: same
+      format, value, text and formula; cells with a text zone or a note are
+      never similar */
+  bool isSimilarTo(Cell const &cell) const
+  {
+    if (m_textZone || cell.m_textZone || m_hasNote || cell.m_hasNote)
+      return false;
+    if (getFormat().m_format!=cell.getFormat().m_format ||
+        getFormat().m_numberFormat!=cell.getFormat().m_numberFormat)
+      return false;
+    auto const &content=cell.m_content;
+    if (m_content.m_contentType!=content.m_contentType || m_content.m_valueSet!=content.m_valueSet ||
+        m_content.m_value<content.m_value || m_content.m_value>content.m_value ||
+        m_content.m_text!=content.m_text || m_content.m_formula.size()!=content.m_formula.size())
+      return false;
+    for (size_t i=0; i<m_content.m_formula.size(); ++i) {
+      auto const &inst=m_content.m_formula[i];
+      auto const &oInst=content.m_formula[i];
+      if (inst.m_type!=oInst.m_type || inst.m_content!=oInst.m_content || inst.m_longValue!=oInst.m_longValue ||
+          inst.m_doubleValue<oInst.m_doubleValue || inst.m_doubleValue>oInst.m_doubleValue ||
+          inst.m_sheet!=oInst.m_sheet || inst.m_sheetId!=oInst.m_sheetId || inst.m_sheetIdRelative!=oInst.m_sheetIdRelative)
+        return false;
+      for (int j=0; j<2; ++j) {
+        if (inst.m_position[j]!=oInst.m_position[j] || inst.m_positionRelative[j]!=oInst.m_positionRelative[j])
+          return false;
+      }
+    }
+    return true;
+  }
   //! the cell content
   STOFFCellContent m_content;
   //! the text zone(if set)
@@ -318,6 +353,26 @@ public:
     if (actAttribute)
       m_colToAttributeMap[actPos]=actAttribute;
   }
+  //! returns true if the two rows have the same attributes and similar cells
+  bool isSimilarTo(RowContent const &row) const
+  {
+    if (m_colToAttributeMap.size()!=row.m_colToAttributeMap.size() ||
+        m_colToCellMap.size()!=row.m_colToCellMap.size())
+      return false;
+    for (auto it=m_colToAttributeMap.begin(), oIt=row.m_colToAttributeMap.begin(); it!=m_colToAttributeMap.end(); ++it, ++oIt) {
+      if (it->first!=oIt->first || it->second.get()!=oIt->second.get())
+        return false;
+    }
+    for (auto it=m_colToCellMap.begin(), oIt=row.m_colToCellMap.begin(); it!=m_colToCellMap.end(); ++it, ++oIt) {
+      if (it->first!=oIt->first)
+        return false;
+      if (it->second.get()==oIt->second.get())
+        continue;
+      if (!it->second || !oIt->second || !it->second->isSimilarTo(*oIt->second))
+        return false;
+    }
+    return true;
+  }
   //! map col -> cell
   std::map<int, std::shared_ptr<Cell> > m_colToCellMap;
   //! map col -> attribute
@@ -475,6 +530,24 @@ Table::~Table()
 {
 }
 
+////////////////////////////////////////
+//! Internal: a table whose reading is delayed
+struct DelayedTable {
+  //! constructor
+  DelayedTable(long pos, std::shared_ptr<Table> table, std::shared_ptr<StarZone> zone)
+    : m_position(pos)
+    , m_table(table)
+    , m_zone(zone)
+  {
+  }
+  //! the table position
+  long m_position;
+  //! the table
+  std::shared_ptr<Table> m_table;
+  //! a zone which stores the reading state (versions, encoding, records, pools) at the table position
+  std::shared_ptr<StarZone> m_zone;
+};
+
 ////////////////////////////////////////
 //! Internal: the state of a StarObjectSpreadsheet
 struct State {
@@ -484,6 +557,7 @@ struct State {
     , m_tableList()
     , m_sheetNames()
     , m_pageStyle("")
+    , m_sharedDataMutex()
   {
   }
   //! the model
@@ -494,6 +568,8 @@ struct State {
   std::vector<librevenge::RVNGString> m_sheetNames;
   //! the main page style
   librevenge::RVNGString m_pageStyle;
+  //! the mutex used to protect the pools when the tables are read concurrently
+  std::mutex m_sharedDataMutex;
 };
 
 ////////////////////////////////////////
@@ -645,7 +721,24 @@ bool StarObjectSpreadsheet::send(STOFFSpreadsheetListenerPtr listener)
       }
       if (it==newRowSet.end())
         break;
-      listener->openSheetRow(sheet.getRowHeight(row), librevenge::RVNG_POINT, *it-row);
+      // merge the following blocks of rows which are similar to this one
+      float height=sheet.getRowHeight(row);
+      auto *rowC=sheet.getRow(row);
+      if (rowC) rowC->compressItemList();
+      while (true) {
+        auto nextIt=it;
+        if (++nextIt==newRowSet.end())
+          break;
+        float nextHeight=sheet.getRowHeight(*it);
+        if (nextHeight<height || nextHeight>height)
+          break;
+        auto *nextRowC=sheet.getRow(*it);
+        if (nextRowC) nextRowC->compressItemList();
+        if ((rowC==0)!=(nextRowC==0) || (rowC && !rowC->isSimilarTo(*nextRowC)))
+          break;
+        it=nextIt;
+      }
+      listener->openSheetRow(height, librevenge::RVNG_POINT, *it-row);
       sendRow(int(t), row, listener);
       listener->closeSheetRow();
     }
@@ -655,6 +748,32 @@ bool StarObjectSpreadsheet::send(STOFFSpreadsheetListenerPtr listener)
   return true;
 }
 
+bool StarObjectSpreadsheet::extractText(STOFFTextExtractor &extractor)
+{
+  for (size_t t=0; t<m_spreadsheetState->m_tableList.size(); ++t) {
+    if (!m_spreadsheetState->m_tableList[t]) continue;
+    auto const &sheet=*m_spreadsheetState->m_tableList[t];
+    for (auto const &it : sheet.m_rowToRowContentMap) {
+      for (auto const &cIt : it.second.m_colToCellMap) {
+        if (!cIt.second) continue;
+        auto const &cell=*cIt.second;
+        if (cell.m_content.m_contentType==STOFFCellContent::C_TEXT_BASIC)
+          extractor.insertParagraph(cell.m_content.m_text);
+        else if (cell.m_content.m_contentType==STOFFCellContent::C_TEXT && cell.m_textZone)
+          cell.m_textZone->extractText(extractor);
+        if (cell.m_hasNote && !cell.m_notes[0].empty()) {
+          extractor.openParagraph();
+          extractor.insertUnicodeString(cell.m_notes[0]);
+          extractor.closeParagraph();
+        }
+      }
+    }
+    if (m_spreadsheetState->m_model)
+      m_spreadsheetState->m_model->extractPageText(int(t), extractor);
+  }
+  return true;
+}
+
 bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListenerPtr listener)
 {
   if (!listener || table<0 || table>=int(m_spreadsheetState->m_tableList.size()) || !m_spreadsheetState->m_tableList[size_t(table)]) {
@@ -665,6 +784,7 @@ bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListener
   auto *rowC=sheet.getRow(row);
   if (!rowC) return true;
   rowC->compressItemList();
+  int const maxCol=std::numeric_limits<int>::max();
 
   // we need to go through the row style list and the cell list in parallel
   bool checkStyle=false;
@@ -683,6 +803,8 @@ bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListener
   }
 
   StarObjectSpreadsheetInternal::Cell emptyCell;
+  auto pool=findItemPool(StarItemPool::T_SpreadsheetPool, false);
+  StarState cellState(pool.get(), *this);
   while (checkStyle || checkCell) {
     int newCol=checkCell ? cIt->first : -1;
     if (checkStyle && sIt->first[1] < actStyleCol) {
@@ -693,36 +815,45 @@ bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListener
     if (checkStyle && (!checkCell || actStyleCol<newCol)) {
       emptyCell.setPosition(STOFFVec2i(actStyleCol, row));
       int numRepeated=(checkCell && newCol<=sIt->first[1]) ? newCol-actStyleCol : sIt->first[1]-actStyleCol+1;
-      sendCell(emptyCell, sIt->second ? sIt->second.get() : 0, table, numRepeated, listener);
+      sendCell(emptyCell, sIt->second ? sIt->second.get() : 0, cellState, table, numRepeated, listener);
       actStyleCol += numRepeated;
       continue;
     }
     if (!checkCell)
       break;
-    if (checkStyle && newCol==actStyleCol) {
-      sendCell(cIt->second ? *cIt->second : emptyCell, sIt->second ? sIt->second.get() : 0, table, 1, listener);
-      ++actStyleCol;
-    }
-    else
-      sendCell(cIt->second ? *cIt->second : emptyCell, 0, table, 1, listener);
-    ++cIt;
+    // look for the following similar cells which have the same attribute
+    bool hasStyle=checkStyle && newCol==actStyleCol;
+    int lastCol=hasStyle ? sIt->first[1] : checkStyle ? actStyleCol-1 : maxCol;
+    int numRepeated=1;
+    auto nextIt=cIt;
+    ++nextIt;
+    if (cIt->second) {
+      while (nextIt!=rowC->m_colToCellMap.end() && nextIt->first==newCol+numRepeated && nextIt->first<=lastCol &&
+             nextIt->second && cIt->second->isSimilarTo(*nextIt->second)) {
+        ++numRepeated;
+        ++nextIt;
+      }
+    }
+    sendCell(cIt->second ? *cIt->second : emptyCell, (hasStyle && sIt->second) ? sIt->second.get() : 0, cellState, table, numRepeated, listener);
+    if (hasStyle)
+      actStyleCol+=numRepeated;
+    cIt=nextIt;
     checkCell=cIt!=rowC->m_colToCellMap.end();
   }
   return true;
 }
 
-bool StarObjectSpreadsheet::sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener)
+bool StarObjectSpreadsheet::sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, StarState &state, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener)
 {
   if (!listener) {
     STOFF_DEBUG_MSG(("StarObjectSpreadsheet::send: can not find the listener\n"));
     return false;
   }
   if (attrib) {
-    auto pool=findItemPool(StarItemPool::T_SpreadsheetPool, false);
-    StarState state(pool.get(), *this);
+    state.reinitialize();
     attrib->addTo(state);
-    cell.setFont(state.m_font);
-    cell.setCellStyle(state.m_cell);
+    cell.setFont(state.m_font.get());
+    cell.setCellStyle(state.m_cell.get());
     // checkme: we need the pool here
     getFormatManager()->updateNumberingProperties(cell);
   }
@@ -838,6 +969,7 @@ try
   ascFile.addNote(f.str().c_str());
   long lastPos=zone.getRecordLastPosition();
   int version=0, maxRow=8191;
+  std::vector<StarObjectSpreadsheetInternal::DelayedTable> delayedTables;
   while (!input->isEnd() && input->tell()<lastPos) {
     long pos=input->tell();
     uint16_t subId;
@@ -851,6 +983,22 @@ try
       std::shared_ptr<StarObjectSpreadsheetInternal::Table> table;
       table.reset(new StarObjectSpreadsheetInternal::Table(version, maxRow));
       m_spreadsheetState->m_tableList.push_back(table);
+      if (useThreads() && std::thread::hardware_concurrency()>1) {
+        /* only store the table's position and the zone state at this position,
+           the tables will be read when all the document's data are read */
+        std::shared_ptr<StarZone> tableZone(new StarZone(input, "", "SCTable", getPassword()));
+        tableZone->copyStateFrom(zone);
+        input->seek(pos+2, librevenge::RVNG_SEEK_SET);
+        if (!zone.openSCRecord()) {
+          input->seek(pos+2, librevenge::RVNG_SEEK_SET);
+          break;
+        }
+        delayedTables.push_back(StarObjectSpreadsheetInternal::DelayedTable(pos+2, table, tableZone));
+        input->seek(zone.getRecordLastPosition(), librevenge::RVNG_SEEK_SET);
+        zone.closeSCRecord("SCTable");
+        ok=true;
+        break;
+      }
       ok=readSCTable(zone, *table);
       break;
     }
@@ -1664,6 +1812,11 @@ try
     zone.closeSCRecord("SCCalcDocument");
   }
   zone.closeSCRecord("SCCalcDocument");
+  if (!delayedTables.empty()) {
+    long actPos=input->tell();
+    readSCTables(input, delayedTables);
+    input->seek(actPos, librevenge::RVNG_SEEK_SET);
+  }
   return true;
 }
 catch (...)
@@ -1773,6 +1926,67 @@ bool StarObjectSpreadsheet::readSfxStyleSheets(STOFFInputStreamPtr input, std::s
 // Low level
 //
 ////////////////////////////////////////////////////////////
+void StarObjectSpreadsheet::readSCTables(STOFFInputStreamPtr input, std::vector<StarObjectSpreadsheetInternal::DelayedTable> const &tables)
+{
+  size_t numThreads=tables.size()>1 ? std::min<size_t>(size_t(std::thread::hardware_concurrency()), tables.size()) : 1;
+  // each thread needs its own stream, so copy the input data in a buffer which will be shared by the streams
+  std::shared_ptr<std::vector<unsigned char> > buffer;
+  if (numThreads>1 && input->size()>0) {
+    input->seek(0, librevenge::RVNG_SEEK_SET);
+    unsigned long numRead;
+    auto const *data=input->read(size_t(input->size()), numRead);
+    if (data && long(numRead)==input->size())
+      buffer=std::make_shared<std::vector<unsigned char> >(data, data+numRead);
+  }
+  if (!buffer) {
+    for (auto const &table : tables) {
+      if (!table.m_table || !table.m_zone) continue;
+      input->seek(table.m_position, librevenge::RVNG_SEEK_SET);
+      if (!readSCTable(*table.m_zone, *table.m_table)) {
+        STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCTables: can not read a table\n"));
+      }
+    }
+    return;
+  }
+
+  std::atomic<size_t> nextTable(0);
+  // as in the serial code, the first exception stops the reading and is rethrown
+  std::mutex exceptionMutex;
+  std::exception_ptr exception;
+  auto *guard=libstoff::ParseGuard::getCurrent();
+  auto readTables=[this, &buffer, &tables, &nextTable, &exceptionMutex, &exception, input, guard]() {
+    libstoff::ParseGuard::setCurrent(guard);
+    try {
+      std::shared_ptr<librevenge::RVNGInputStream> stream(new STOFFStringStream(buffer));
+      STOFFInputStreamPtr tInput(new STOFFInputStream(stream, input->readInverted()));
+      for (size_t t=nextTable++; t<tables.size(); t=nextTable++) {
+        auto const &table=tables[t];
+        if (!table.m_table || !table.m_zone) continue;
+        StarZone tZone(tInput, "", "SCTable", getPassword());
+        tZone.copyStateFrom(*table.m_zone);
+        tInput->seek(table.m_position, librevenge::RVNG_SEEK_SET);
+        if (!readSCTable(tZone, *table.m_table)) {
+          STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCTables: can not read a table\n"));
+        }
+      }
+    }
+    catch (...) {
+      nextTable=tables.size();
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      if (!exception)
+        exception=std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i=1; i<numThreads; ++i)
+    threads.push_back(std::thread(readTables));
+  readTables();
+  for (auto &thread : threads)
+    thread.join();
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
 bool StarObjectSpreadsheet::readSCTable(StarZone &zone, StarObjectSpreadsheetInternal::Table &table)
 {
   STOFFInputStreamPtr input=zone.input();
@@ -1940,8 +2154,8 @@ bool StarObjectSpreadsheet::readSCTable(StarZone &zone, StarObjectSpreadsheetInt
         if (!string.empty()) {
           static char const *(wh[])= {"name", "comment", "pass"};
           f << wh[i] << "=" << libstoff::getString(string).cstr() << ",";
-          if (i==0 && !m_spreadsheetState->m_tableList.empty() && m_spreadsheetState->m_tableList.back())
-            m_spreadsheetState->m_tableList.back()->m_name=libstoff::getString(string);
+          if (i==0)
+            table.m_name=libstoff::getString(string);
         }
         if (i==2) break;
         *input>>bVal;
@@ -2129,6 +2343,8 @@ bool StarObjectSpreadsheet::readSCColumn(StarZone &zone, StarObjectSpreadsheetIn
       uint16_t nCount;
       *input >> nCount;
       f << "n=" << nCount << ",";
+      // the pool can be shared by concurrent readSCTable
+      std::lock_guard<std::mutex> lock(m_spreadsheetState->m_sharedDataMutex);
       std::shared_ptr<StarItemPool> pool=findItemPool(StarItemPool::T_SpreadsheetPool, false);
       if (!pool) {
         STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCColumn:can not read the spreadsheet pool, create a new one\n"));
@@ -2184,6 +2400,43 @@ bool StarObjectSpreadsheet::readSCColumn(StarZone &zone, StarObjectSpreadsheetIn
   return true;
 }
 
+int StarObjectSpreadsheet::readSCValueCells(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column, int maxCells, long lastPos, long cellSize)
+{
+  STOFFInputStreamPtr input=zone.input();
+  long pos=input->tell();
+  if (maxCells<=0 || pos+cellSize>lastPos) return 0;
+  // check the first cell's type before reading a block
+  input->seek(2, librevenge::RVNG_SEEK_CUR);
+  bool const isValue=input->readULong(1)==1;
+  input->seek(pos, librevenge::RVNG_SEEK_SET);
+  if (!isValue) return 0;
+
+  long const maxSize=std::min(lastPos-pos, long(maxCells)*cellSize);
+  unsigned long numRead;
+  uint8_t const *data=input->read(size_t(maxSize), numRead);
+  bool const inverted=input->readInverted();
+  int n=0;
+  while (data && long(n+1)*cellSize<=long(numRead)) {
+    uint8_t const *c=data+long(n)*cellSize;
+    // stop on the first cell which needs the generic code
+    if (c[2]!=1 || (cellSize==12 && (c[3]&0xf))) break;
+    double value;
+    bool isNan;
+    if (!STOFFInputStream::decodeDoubleReverted8(c+cellSize-8, value, isNan)) break;
+    int const row=inverted ? int(c[0])|(int(c[1])<<8) : (int(c[0])<<8)|int(c[1]);
+    auto &cell=table.getCell(STOFFVec2i(column, row));
+    STOFFCell::Format format=cell.getFormat();
+    format.m_format=STOFFCell::F_NUMBER;
+    cell.m_content.m_contentType=STOFFCellContent::C_NUMBER;
+    cell.m_content.setValue(value);
+    cell.setFormat(format);
+    ++n;
+  }
+  libstoff::ParseGuard::checkAllocation(static_cast<unsigned long>(n), sizeof(StarObjectSpreadsheetInternal::Cell));
+  input->seek(pos+long(n)*cellSize, librevenge::RVNG_SEEK_SET);
+  return n;
+}
+
 bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column)
 {
   STOFFInputStreamPtr input=zone.input();
@@ -2205,8 +2458,19 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
 
   long lastPos=zone.getRecordLastPosition();
   int const version=table.getLoadingVersion();
+  // a simple value cell: row, type, [flag], value
+  long const valueCellSize=version>=7 ? 12 : 11;
   for (int i=0; i<count; ++i) {
     pos=input->tell();
+    int const numValues=readSCValueCells(zone, table, column, std::min(count-i, 1024), lastPos, valueCellSize);
+    if (numValues>0) {
+      f.str("");
+      f << "SCData-" << i << ":values[" << numValues << "],";
+      ascFile.addPos(pos);
+      ascFile.addNote(f.str().c_str());
+      i+=numValues-1;
+      continue;
+    }
     f.str("");
     f << "SCData-" << i << ":";
     if (input->tell()+4>lastPos) {
@@ -2360,7 +2624,13 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
         if (unkn&0xf) input->seek((unkn&0xf), librevenge::RVNG_SEEK_CUR);
       }
       std::shared_ptr<StarObjectSmallText> textZone(new StarObjectSmallText(*this, true));
-      if (!textZone->read(zone, lastPos) || input->tell()>lastPos) {
+      bool textOk;
+      {
+        // the edit text uses the document's pools
+        std::lock_guard<std::mutex> lock(m_spreadsheetState->m_sharedDataMutex);
+        textOk=textZone->read(zone, lastPos);
+      }
+      if (!textOk || input->tell()>lastPos) {
         STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCData: can not open some edit text \n"));
         f << "###edit";
         ok=false;
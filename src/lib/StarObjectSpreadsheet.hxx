@@ -47,11 +47,13 @@ namespace StarObjectSpreadsheetInternal
 {
 class Cell;
 class Table;
+struct DelayedTable;
 
 struct State;
 }
 
 class StarAttribute;
+class StarState;
 class StarZone;
 class STOFFPageSpan;
 
@@ -71,12 +73,16 @@ public:
   bool parse();
   //! try to send the spreadsheet
   bool send(STOFFSpreadsheetListenerPtr listener);
+  /** try to send only the text of the cells, notes and drawing objects to a text extractor
+
+   \note a text cell is sent as a paragraph, the numeric and the formula cells are ignored */
+  bool extractText(STOFFTextExtractor &extractor);
   /** try to send a spreadsheet row.
 
    \note this function does not call openSheetRow,closeSheetRow */
   bool sendRow(int table, int row, STOFFSpreadsheetListenerPtr listener);
   /** try to send a cell */
-  bool sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener);
+  bool sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, StarState &state, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener);
   /** try to update the page span */
   bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages);
 protected:
@@ -90,10 +96,17 @@ protected:
 
   //! try to read a SCTable
   bool readSCTable(StarZone &zone, StarObjectSpreadsheetInternal::Table &table);
+  /** try to read a list of SCTable given their positions and their zone states.
+
+      \note if there are several tables, they are decoded concurrently, each thread using its own zone */
+  void readSCTables(STOFFInputStreamPtr input, std::vector<StarObjectSpreadsheetInternal::DelayedTable> const &tables);
   //! try to read a SCColumn
   bool readSCColumn(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column, long lastPos);
   //! try to read a list of data
   bool readSCData(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column);
+  /** try to read a run of at most maxCells simple value cells in one block,
+      returns the number of read cells */
+  int readSCValueCells(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column, int maxCells, long lastPos, long cellSize);
 
   //! try to read a change trak
   bool readSCChangeTrack(StarZone &zone, int version, long lastPos);
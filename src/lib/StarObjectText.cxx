@@ -32,10 +32,14 @@
 */
 
 #include <cstring>
+#include <exception>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <sstream>
+#include <system_error>
+#include <thread>
 
 #include <librevenge/librevenge.h>
 
@@ -44,6 +48,7 @@
 #include "STOFFPageSpan.hxx"
 #include "STOFFParagraph.hxx"
 #include "STOFFSection.hxx"
+#include "STOFFTextExtractor.hxx"
 #include "STOFFTextListener.hxx"
 
 #include "SWFieldManager.hxx"
@@ -80,17 +85,11 @@ Content::~Content()
 {
 }
 
-void Content::inventoryPages(StarState &state) const
+void Content::extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const
 {
-  if (!state.m_global->m_pool) {
-    STOFF_DEBUG_MSG(("StarObjectTextInternal::Content::inventoryPages: can not find the pool\n"));
-    return;
-  }
   for (auto &z : m_zoneList) {
     if (z)
-      z->inventoryPage(state);
-    if (state.m_global->m_pageNameList.empty())
-      state.m_global->m_pageNameList.push_back("");
+      z->extractText(extractor, pool);
   }
 }
 
@@ -172,6 +171,7 @@ bool GraphZone::send(STOFFListenerPtr listener, StarState &/* state */) const
     STOFF_DEBUG_MSG(("StarObjectTextInternal::GraphZone::send: can not find the graph name\n"));
     return false;
   }
+  if (listener->skipPictures()) return true;
   STOFFEmbeddedObject localPicture;
   if (!m_oleParser || !StarFileManager::readEmbeddedPicture(m_oleParser, m_names[0].cstr(), localPicture) || localPicture.isEmpty()) {
     STOFF_DEBUG_MSG(("StarObjectTextInternal: sorry, can not find object %s\n", m_names[0].cstr()));
@@ -256,6 +256,12 @@ struct SectionZone final : public Zone {
   }
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state) const final;
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const final
+  {
+    if (m_content)
+      m_content->extractText(extractor, pool);
+  }
   //! the section name
   librevenge::RVNGString m_name;
   //! the section condition
@@ -307,6 +313,10 @@ struct TextZone final : public Zone {
   void inventoryPage(StarState &state) const final;
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state) const final;
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const final;
+  //! returns true if some character attributes begin in the first character
+  bool hasFirstCharAttribute() const;
   //! the text
   std::vector<uint32_t> m_text;
   //! the text initial position
@@ -360,6 +370,80 @@ void TextZone::inventoryPage(StarState &state) const
     state.m_global->m_pageNameList.push_back("");
 }
 
+////////////////////////////////////////
+// Content
+////////////////////////////////////////
+void Content::addTextZone(std::shared_ptr<TextZone> zone)
+{
+  if (!zone) return;
+  size_t id=m_zoneList.size();
+  m_zoneList.push_back(zone);
+  /* a text zone with the same style as the previous text zone and no
+     attribute in its first character only adds a page if the current
+     break is a page break, so store it as a follower of the previous zone */
+  if (!m_pageZoneList.empty() && zone->m_styleName==m_lastStyleName && !zone->hasFirstCharAttribute()) {
+    ++m_pageZoneList.back().m_numFollowers;
+    return;
+  }
+  m_lastStyleName=zone->m_styleName;
+  m_pageZoneList.push_back(PageZone(id));
+}
+
+void Content::inventoryPages(StarState &state) const
+{
+  if (!state.m_global->m_pool) {
+    STOFF_DEBUG_MSG(("StarObjectTextInternal::Content::inventoryPages: can not find the pool\n"));
+    return;
+  }
+  // only the zones stored in m_pageZoneList can modify the list of pages
+  auto &pageNameList=state.m_global->m_pageNameList;
+  if (!m_zoneList.empty() && (m_pageZoneList.empty() || m_pageZoneList[0].m_zoneId!=0) && pageNameList.empty())
+    pageNameList.push_back("");
+  for (auto const &pageZone : m_pageZoneList) {
+    if (pageZone.m_zoneId>=m_zoneList.size() || !m_zoneList[pageZone.m_zoneId])
+      continue;
+    m_zoneList[pageZone.m_zoneId]->inventoryPage(state);
+    if (pageNameList.empty())
+      pageNameList.push_back("");
+    if (state.m_break==4)
+      pageNameList.resize(pageNameList.size()+pageZone.m_numFollowers, "");
+  }
+}
+
+bool TextZone::hasFirstCharAttribute() const
+{
+  for (auto const &attrib : m_charAttributeList) {
+    if ((attrib.m_position[1]<0 && attrib.m_position[0]>0) || attrib.m_position[0]>0)
+      continue;
+    if (attrib.m_attribute)
+      return true;
+  }
+  return false;
+}
+
+void TextZone::extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const
+{
+  int outlineLevel=0;
+  if (pool && !m_styleName.empty()) {
+    auto const *style=pool->findStyleWithFamily(m_styleName, StarItemStyle::F_Paragraph);
+    if (style && style->m_outlineLevel>=0 && style->m_outlineLevel<20)
+      outlineLevel=style->m_outlineLevel+1;
+  }
+  extractor.openParagraph(outlineLevel);
+  // the footnotes, fields, ... are anchored on a character which must be ignored
+  std::set<size_t> anchorSet;
+  for (auto const &attrib : m_charAttributeList) {
+    if (attrib.m_position[1]<0 && attrib.m_position[0]>=0)
+      anchorSet.insert(size_t(attrib.m_position[0]));
+  }
+  for (size_t c=0; c<m_text.size(); ++c) {
+    if (!anchorSet.empty() && anchorSet.find(c<m_textSourcePosition.size() ? m_textSourcePosition[c] : 10000)!=anchorSet.end())
+      continue;
+    extractor.insertUnicode(m_text[c]);
+  }
+  extractor.closeParagraph();
+}
+
 bool TextZone::send(STOFFListenerPtr listener, StarState &state) const
 {
   if (!listener || !listener->canWriteText()) {
@@ -377,8 +461,8 @@ bool TextZone::send(STOFFListenerPtr listener, StarState &state) const
       StarItemStyle const *style=state.m_global->m_pool->findStyleWithFamily(m_styleName, StarItemStyle::F_Paragraph);
       if (style) {
         if (style->m_outlineLevel>=0 && style->m_outlineLevel<20) {
-          state.m_paragraph.m_outline=true;
-          state.m_paragraph.m_listLevelIndex=style->m_outlineLevel+1;
+          state.m_paragraph.edit().m_outline=true;
+          state.m_paragraph.edit().m_listLevelIndex=style->m_outlineLevel+1;
         }
         for (auto it : style->m_itemSet.m_whichToItemMap) {
           if (it.second && it.second->m_attribute)
@@ -393,7 +477,7 @@ bool TextZone::send(STOFFListenerPtr listener, StarState &state) const
       }
     }
   }
-  STOFFFont mainFont=state.m_font;
+  STOFFFont mainFont=state.m_font.get();
   listener->setFont(mainFont);
   if (!m_markList.empty()) {
     static bool first=true;
@@ -443,7 +527,6 @@ bool TextZone::send(STOFFListenerPtr listener, StarState &state) const
     if (fontChange) {
       lineState.reinitializeLineData();
       lineState.m_font=mainFont;
-      STOFFFont &font=lineState.m_font;
       for (auto const &attrib : m_charAttributeList) {
         if ((attrib.m_position[1]<0 && attrib.m_position[0]>=0 && attrib.m_position[0]!=int(srcPos)) ||
             (attrib.m_position[0]>=0 && attrib.m_position[0]>int(srcPos)) ||
@@ -502,28 +585,29 @@ bool TextZone::send(STOFFListenerPtr listener, StarState &state) const
           lineState.m_refMark.clear();
         }
       }
+      auto const &font=lineState.m_font.get();
       softHyphen=font.m_softHyphen;
       listener->setFont(font);
       if (c==0) {
         int level=m_level;
         if (level==200) {
           level=state.m_global->m_listLevel;
-          lineState.m_paragraph.m_bulletVisible=true; // useMe
+          lineState.m_paragraph.edit().m_bulletVisible=true; // useMe
         }
-        if (!lineState.m_paragraph.m_outline) {
+        if (!lineState.m_paragraph->m_outline) {
           if (level>=0 && (!state.m_global->m_list || state.m_global->m_list->numLevels()<=int(level))) {
             STOFF_DEBUG_MSG(("StarObjectTextInternal::TextZone::send: oops can not find the list\n"));
             level=-1;
           }
           if (level>=0) {
-            lineState.m_paragraph.m_listLevel = state.m_global->m_list->getLevel(level);
-            lineState.m_paragraph.m_listId = state.m_global->m_list->getId();
-            lineState.m_paragraph.m_listLevelIndex = level+1;
+            lineState.m_paragraph.edit().m_listLevel = state.m_global->m_list->getLevel(level);
+            lineState.m_paragraph.edit().m_listId = state.m_global->m_list->getId();
+            lineState.m_paragraph.edit().m_listLevelIndex = level+1;
           }
           else
-            lineState.m_paragraph.m_listLevelIndex=0;
+            lineState.m_paragraph.edit().m_listLevelIndex=0;
         }
-        listener->setParagraph(lineState.m_paragraph);
+        listener->setParagraph(lineState.m_paragraph.get());
       }
       if (c==0 && m_format) {
         StarState cState(lineState.m_global->m_pool, lineState.m_global->m_object, lineState.m_global->m_relativeUnit);
@@ -577,8 +661,19 @@ bool TextZone::send(STOFFListenerPtr listener, StarState &state) const
       listener->insertTab();
     else if (m_text[c]==0xa)
       listener->insertEOL(true);
-    else
-      listener->insertUnicode(m_text[c]);
+    else {
+      // send the next characters which do not need any special treatment in one run
+      size_t end=c+1;
+      for (; end<m_text.size(); ++end) {
+        if (m_text[end]==0x9 || m_text[end]==0xa || int(end)==endLinkPos || int(end)==endRefMarkPos)
+          break;
+        size_t endSrcPos=end<m_textSourcePosition.size() ? m_textSourcePosition[end] : 10000;
+        if (posSetIt!=modPosSet.end() && *posSetIt <= endSrcPos)
+          break;
+      }
+      listener->insertUnicodeRun(&m_text[c], end-c);
+      c=end-1;
+    }
   }
   if (endLinkPos>=0) // check that not link is opened
     listener->closeLink();
@@ -601,6 +696,12 @@ struct Table final : public Zone {
   }
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state) const final;
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const final
+  {
+    if (m_table)
+      m_table->extractText(extractor, pool);
+  }
   //! the table
   std::shared_ptr<StarTable> m_table;
 };
@@ -618,6 +719,102 @@ bool Table::send(STOFFListenerPtr listener, StarState &state) const
   return m_table->send(listener, state);
 }
 
+////////////////////////////////////////
+//! Internal: a small class used to call the independent zone's readers in other threads
+class ReaderThreads
+{
+public:
+  //! constructor
+  ReaderThreads()
+    : m_threadList()
+    , m_mutex()
+    , m_exception()
+  {
+  }
+  //! destructor
+  ~ReaderThreads()
+  {
+    join();
+  }
+  //! calls reader in a new thread (or directly if the thread can not be created)
+  void launch(std::function<void()> const &reader)
+  {
+    try {
+      auto *guard=libstoff::ParseGuard::getCurrent();
+      m_threadList.push_back(std::thread([this, reader, guard]() {
+        libstoff::ParseGuard::setCurrent(guard);
+        try {
+          reader();
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if (!m_exception)
+            m_exception=std::current_exception();
+        }
+      }));
+    }
+    catch (std::system_error const &) {
+      STOFF_DEBUG_MSG(("StarObjectTextInternal::ReaderThreads::launch: can not create a thread\n"));
+      reader();
+    }
+  }
+  //! waits for all the readers, rethrows the first exception thrown by a reader (if any)
+  void wait()
+  {
+    join();
+    if (!m_exception) return;
+    auto exception=m_exception;
+    m_exception=nullptr;
+    std::rethrow_exception(exception);
+  }
+protected:
+  //! joins all the threads
+  void join()
+  {
+    for (auto &thread : m_threadList) {
+      if (thread.joinable())
+        thread.join();
+    }
+    m_threadList.clear();
+  }
+  //! the list of thread
+  std::vector<std::thread> m_threadList;
+  //! the mutex used to protect m_exception
+  std::mutex m_mutex;
+  //! the first exception thrown by a reader
+  std::exception_ptr m_exception;
+private:
+  ReaderThreads(ReaderThreads const &orig) = delete;
+  ReaderThreads &operator=(ReaderThreads const &orig) = delete;
+};
+
+////////////////////////////////////////
+//! Internal: the data used to send the main content progressively
+struct ProgressiveSender {
+  //! constructor
+  explicit ProgressiveSender(StarObjectText::ListenerCreator const &creator)
+    : m_createListener(creator)
+    , m_listener()
+    , m_pool()
+    , m_pageState()
+    , m_sendState()
+    , m_numPageNames(0)
+  {
+  }
+  //! the function used to create the listener
+  StarObjectText::ListenerCreator m_createListener;
+  //! the listener (created when the first zone is sent)
+  STOFFTextListenerPtr m_listener;
+  //! the writer pool
+  std::shared_ptr<StarItemPool> m_pool;
+  //! the state used to inventory the pages
+  std::shared_ptr<StarState> m_pageState;
+  //! the state used to send the zones
+  std::shared_ptr<StarState> m_sendState;
+  //! the number of page names used to create the last page spans
+  size_t m_numPageNames;
+};
+
 ////////////////////////////////////////
 //! Internal: the state of a StarObjectText
 struct State {
@@ -629,6 +826,7 @@ struct State {
     , m_numericRuler()
     , m_pageStyle()
     , m_model()
+    , m_sender()
   {
   }
   //! the number of pages
@@ -643,6 +841,8 @@ struct State {
   std::shared_ptr<StarObjectPageStyle> m_pageStyle;
   //! the drawing model
   std::shared_ptr<StarObjectModel> m_model;
+  //! the progressive sender (if the main content must be sent when it is read)
+  std::shared_ptr<ProgressiveSender> m_sender;
 };
 
 }
@@ -711,6 +911,80 @@ bool StarObjectText::sendPages(STOFFTextListenerPtr listener)
   return true;
 }
 
+void StarObjectText::sendReadZones(StarObjectTextInternal::Content &content)
+{
+  auto sender=m_textState->m_sender;
+  if (!sender || content.m_zoneList.empty()) return;
+  if (!sender->m_pageState) {
+    sender->m_pool=findItemPool(StarItemPool::T_WriterPool, false);
+    sender->m_pageState.reset(new StarState(sender->m_pool.get(), *this));
+  }
+  auto &pageNameList=sender->m_pageState->m_global->m_pageNameList;
+  content.inventoryPages(*sender->m_pageState);
+  if (!sender->m_listener || pageNameList.size()!=sender->m_numPageNames) {
+    // the number of pages has changed, recompute the page spans
+    std::vector<STOFFPageSpan> pageSpan;
+    int numPages=0;
+    if (m_textState->m_pageStyle)
+      m_textState->m_pageStyle->updatePageSpans(pageNameList, pageSpan, numPages);
+    if (numPages<=0 || pageSpan.empty()) {
+      numPages=1000;
+      STOFFPageSpan ps;
+      ps.m_pageSpan=numPages;
+      pageSpan.clear();
+      pageSpan.push_back(ps);
+    }
+    m_textState->m_numPages=numPages;
+    sender->m_numPageNames=pageNameList.size();
+    if (!sender->m_listener) {
+      sender->m_listener=sender->m_createListener(pageSpan);
+      if (!sender->m_listener) {
+        STOFF_DEBUG_MSG(("StarObjectText::sendReadZones: can not create the listener\n"));
+        m_textState->m_sender.reset();
+        return;
+      }
+      if (m_textState->m_model) {
+        std::vector<STOFFPageSpan> modelPageSpan;
+        m_textState->m_model->updatePageSpans(modelPageSpan, m_textState->m_numGraphicPages);
+        for (int i=0; i<=m_textState->m_numGraphicPages; ++i)
+          m_textState->m_model->sendPage(i, sender->m_listener);
+      }
+    }
+    else
+      sender->m_listener->setPageSpans(pageSpan);
+  }
+  if (!sender->m_sendState) {
+    StarState state(sender->m_pool.get(), *this);
+    state.m_global->m_numericRuler=m_textState->m_numericRuler;
+    sender->m_sendState.reset(new StarState(state.m_global));
+  }
+  else
+    sender->m_listener->insertEOL();
+  STOFFListenerPtr listener=sender->m_listener;
+  for (size_t t=0; t<content.m_zoneList.size(); ++t) {
+    if (content.m_zoneList[t])
+      content.m_zoneList[t]->send(listener, *sender->m_sendState);
+    if (t+1!=content.m_zoneList.size())
+      listener->insertEOL();
+  }
+  // the zones are sent, we can free them
+  content.m_zoneList.clear();
+  content.m_pageZoneList.clear();
+}
+
+bool StarObjectText::extractText(STOFFTextExtractor &extractor)
+{
+  if (!m_textState->m_mainContent) {
+    STOFF_DEBUG_MSG(("StarObjectText::extractText: can not find any content\n"));
+    return true;
+  }
+  auto pool=findItemPool(StarItemPool::T_WriterPool, false);
+  m_textState->m_mainContent->extractText(extractor, pool.get());
+  if (m_textState->m_model)
+    m_textState->m_model->extractText(extractor);
+  return true;
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -721,7 +995,16 @@ bool StarObjectText::parse()
     return false;
   }
   auto &directory=*getOLEDirectory();
-  StarObject::parse();
+  /* the preview, the document information and the numbering rules do
+     not depend on the other zones, so they can be read in other threads.
+     The remaining zones modify the pools, the format manager, ... and
+     must be read in order, the main document is read when all zones are read */
+  bool useThreads=StarObject::useThreads() && std::thread::hardware_concurrency()>1;
+  StarObjectTextInternal::ReaderThreads readerThreads;
+  std::vector<std::function<void()> > independentReaders;
+  StarObject::parse(useThreads ? &independentReaders : nullptr);
+  for (auto const &reader : independentReaders)
+    readerThreads.launch(reader);
   auto unparsedOLEs=directory.getUnparsedOles();
   STOFFInputStreamPtr input=directory.m_input;
   StarFileManager fileManager;
@@ -742,14 +1025,21 @@ bool StarObjectText::parse()
       base = name.substr(pos+1);
     ole->setReadInverted(true);
     if (base=="SwNumRules") {
-      try {
-        StarZone zone(ole, name, "StarNumericList", getPassword());
-        std::shared_ptr<StarObjectNumericRuler> numericRuler(new StarObjectNumericRuler(*this,true));
-        if (numericRuler->read(zone))
-          m_textState->m_numericRuler=numericRuler;
-      }
-      catch (...) {
-      }
+      // the copy of this object must be created here, the reader only uses its zone and the ruler
+      std::shared_ptr<StarObjectNumericRuler> numericRuler(new StarObjectNumericRuler(*this,true));
+      auto reader=[this, ole, name, numericRuler]() {
+        try {
+          StarZone zone(ole, name, "StarNumericList", getPassword());
+          if (numericRuler->read(zone))
+            m_textState->m_numericRuler=numericRuler;
+        }
+        catch (...) {
+        }
+      };
+      if (useThreads)
+        readerThreads.launch(reader);
+      else
+        reader();
       continue;
     }
     if (base=="SwPageStyleSheets") {
@@ -789,6 +1079,8 @@ bool StarObjectText::parse()
     asciiFile.addNote(f.str().c_str());
     asciiFile.reset();
   }
+  readerThreads.wait();
+  mergeIndependentData();
   if (!mainOle) {
     STOFF_DEBUG_MSG(("StarObjectText::parser: can not find the main writer document\n"));
     return false;
@@ -798,6 +1090,21 @@ bool StarObjectText::parse()
   return true;
 }
 
+bool StarObjectText::parseAndSend(StarObjectText::ListenerCreator const &createListener)
+{
+  m_textState->m_sender.reset(new StarObjectTextInternal::ProgressiveSender(createListener));
+  bool ok;
+  try {
+    ok=parse();
+  }
+  catch (...) {
+    m_textState->m_sender.reset();
+    throw;
+  }
+  m_textState->m_sender.reset();
+  return ok;
+}
+
 bool StarObjectText::readSfxStyleSheets(STOFFInputStreamPtr input, std::string const &name)
 {
   StarZone zone(input, name, "SfxStyleSheets", getPassword());
@@ -895,7 +1202,11 @@ bool StarObjectText::readSWContent(StarZone &zone, std::shared_ptr<StarObjectTex
   ascFile.addNote(f.str().c_str());
 
   long lastPos=zone.getRecordLastPosition();
+  // if needed, send the main zones as soon as they are read
+  bool sendZones=m_textState->m_sender && &content==&m_textState->m_mainContent;
   for (int i=0; i<nNodes; ++i) {
+    if (sendZones)
+      sendReadZones(*content);
     if (input->tell()>=lastPos) break;
     pos=input->tell();
     int cType=input->peek();
@@ -936,7 +1247,7 @@ bool StarObjectText::readSWContent(StarZone &zone, std::shared_ptr<StarObjectTex
       std::shared_ptr<StarObjectTextInternal::TextZone> text;
       done=readSWTextZone(zone, text);
       if (done && text)
-        content->m_zoneList.push_back(text);
+        content->addTextZone(text);
       break;
     }
     case 'l': // related to link
@@ -980,6 +1291,8 @@ bool StarObjectText::readSWContent(StarZone &zone, std::shared_ptr<StarObjectTex
     ascFile.addNote(f.str().c_str());
     zone.closeSWRecord(type, "SWContent");
   }
+  if (sendZones)
+    sendReadZones(*content);
   zone.closeSWRecord('N', "SWContent");
   return true;
 }
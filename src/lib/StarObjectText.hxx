@@ -38,11 +38,13 @@
 #ifndef STAR_OBJECT_TEXT
 #  define STAR_OBJECT_TEXT
 
+#include <functional>
 #include <vector>
 
 #include "libstaroffice_internal.hxx"
 #include "StarObject.hxx"
 
+class StarItemPool;
 class StarState;
 
 namespace StarObjectTextInternal
@@ -61,32 +63,61 @@ struct Zone {
   virtual void inventoryPage(StarState &/*state*/) const
   {
   }
+  //! try to send only the text to a text extractor
+  virtual void extractText(STOFFTextExtractor &/*extractor*/, StarItemPool const */*pool*/) const
+  {
+  }
 };
 
+struct TextZone;
+
 //! Internal: a set of zone
 struct Content {
+  //! a text zone which can modify the list of pages
+  struct PageZone {
+    //! constructor
+    explicit PageZone(size_t zoneId)
+      : m_zoneId(zoneId)
+      , m_numFollowers(0)
+    {
+    }
+    //! the zone index in m_zoneList
+    size_t m_zoneId;
+    //! the number of following text zones with the same style and no beginning attribute
+    size_t m_numFollowers;
+  };
   //! constructor
   Content()
     : m_sectionName("")
     , m_zoneList()
+    , m_pageZoneList()
+    , m_lastStyleName("")
   {
   }
   //! destructor
   ~Content();
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state) const;
+  //! adds a text zone and updates the list of zones which can modify the pages
+  void addTextZone(std::shared_ptr<TextZone> zone);
   //! try to inventory the different pages
   void inventoryPages(StarState &state) const;
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const;
   //! the section name
   librevenge::RVNGString m_sectionName;
   //! the list of text zone
   std::vector<std::shared_ptr<Zone> > m_zoneList;
+  //! the list of text zones which can modify the pages (filled by addTextZone)
+  std::vector<PageZone> m_pageZoneList;
+  //! the style name of the last text zone
+  librevenge::RVNGString m_lastStyleName;
 };
 
 struct GraphZone;
 struct OLEZone;
+struct ProgressiveSender;
 struct SectionZone;
-struct TextZone;
 struct State;
 }
 
@@ -105,13 +136,25 @@ public:
   //! destructor
   ~StarObjectText() final;
 
+  //! the function used to create the listener when the document is sent progressively
+  typedef std::function<STOFFTextListenerPtr(std::vector<STOFFPageSpan> const &pageSpan)> ListenerCreator;
+
   // try to parse all zone
   bool parse();
+  /** try to parse all zones and to send the main content progressively: each zone of the main
+      content is sent as soon as it is read and then freed. createListener is called to create
+      the listener when the first zone is read, ie. when the styles and the page styles are known.
+
+      \note if createListener is called, the zones of the main content are freed when they are sent,
+      so sendPages and extractText can no longer be used */
+  bool parseAndSend(ListenerCreator const &createListener);
 
   /** try to update the page span (to create draw document)*/
   bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages);
   //! try to send the different page
   bool sendPages(STOFFTextListenerPtr listener);
+  /** try to send only the text to a text extractor: no style, no page span and no picture */
+  bool extractText(STOFFTextExtractor &extractor);
 
   //! try to read a image map zone : 'X'
   static bool readSWImageMap(StarZone &zone);
@@ -127,6 +170,8 @@ protected:
   bool readSfxStyleSheets(STOFFInputStreamPtr input, std::string const &fileName);
   //! the main zone
   bool readWriterDocument(STOFFInputStreamPtr input, std::string const &fileName);
+  //! sends the zones of the main content which are already read and frees them
+  void sendReadZones(StarObjectTextInternal::Content &content);
 
   //! the drawing layers ?
   bool readDrawingLayer(STOFFInputStreamPtr input, std::string const &fileName);
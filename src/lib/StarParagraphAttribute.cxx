@@ -203,36 +203,36 @@ StarPAttributeVoid::~StarPAttributeVoid()
 void StarPAttributeBool::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_PARA_SPLIT)
-    state.m_paragraph.m_propertyList.insert("fo:keep-together", m_value ? "auto" : "always");
+    state.m_paragraph.edit().m_propertyList.insert("fo:keep-together", m_value ? "auto" : "always");
   else if (m_type==ATTR_PARA_HANGINGPUNCTUATION)
-    state.m_paragraph.m_propertyList.insert("style:punctuation-wrap", m_value ? "hanging" : "simple");
+    state.m_paragraph.edit().m_propertyList.insert("style:punctuation-wrap", m_value ? "hanging" : "simple");
   else if (m_type==ATTR_PARA_SNAPTOGRID)
-    state.m_paragraph.m_propertyList.insert("style:snap-to-layout-grid", m_value);
+    state.m_paragraph.edit().m_propertyList.insert("style:snap-to-layout-grid", m_value);
   else if (m_type==ATTR_PARA_CONNECT_BORDER)
-    state.m_paragraph.m_propertyList.insert("style:join-border", m_value);
+    state.m_paragraph.edit().m_propertyList.insert("style:join-border", m_value);
   else if (m_type==ATTR_EE_PARA_ASIANCJKSPACING)
-    state.m_paragraph.m_propertyList.insert("style:font-independent-line-spacing", !m_value);
+    state.m_paragraph.edit().m_propertyList.insert("style:font-independent-line-spacing", !m_value);
 }
 
 void StarPAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_PARA_ORPHANS)
-    state.m_paragraph.m_propertyList.insert("fo:orphans", int(m_value));
+    state.m_paragraph.edit().m_propertyList.insert("fo:orphans", int(m_value));
   else if (m_type==ATTR_PARA_WIDOWS)
-    state.m_paragraph.m_propertyList.insert("fo:widows", int(m_value));
+    state.m_paragraph.edit().m_propertyList.insert("fo:widows", int(m_value));
   else if (m_type==ATTR_PARA_VERTALIGN) {
     if (m_value<=4) {
       char const *(wh[])= {"auto", "baseline", "top", "middle", "bottom"};
-      state.m_paragraph.m_propertyList.insert("style:vertical-align", wh[m_value]);
+      state.m_paragraph.edit().m_propertyList.insert("style:vertical-align", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarPAttributeUInt::addTo: unknown vertical align %d\n", int(m_value)));
     }
   }
   else if (m_type==ATTR_EE_PARA_BULLETSTATE)
-    state.m_paragraph.m_bulletVisible=m_value!=0;
+    state.m_paragraph.edit().m_bulletVisible=m_value!=0;
   else if (m_type==ATTR_EE_PARA_OUTLLEVEL)
-    state.m_paragraph.m_listLevelIndex=int(m_value);
+    state.m_paragraph.edit().m_listLevelIndex=int(m_value);
 }
 
 //! add a bool attribute
@@ -645,23 +645,23 @@ void StarPAttributeAdjust::addTo(StarState &state, std::set<StarAttribute const
   if (m_type==ATTR_PARA_ADJUST) {
     switch (m_adjust) {
     case 0:
-      state.m_paragraph.m_propertyList.insert("fo:text-align", "left");
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-align", "left");
       break;
     case 1:
-      state.m_paragraph.m_propertyList.insert("fo:text-align", "right");
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-align", "right");
       break;
     case 2: // block
-      state.m_paragraph.m_propertyList.insert("fo:text-align", "justify");
-      state.m_paragraph.m_propertyList.insert("fo:text-align-last", "default");
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-align", "justify");
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-align-last", "default");
       break;
     case 3:
-      state.m_paragraph.m_propertyList.insert("fo:text-align", "center");
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-align", "center");
       break;
     case 4: // blockline
-      state.m_paragraph.m_propertyList.insert("fo:text-align", "justify");
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-align", "justify");
       break;
     case 5:
-      state.m_paragraph.m_propertyList.insert("fo:text-align", "end");
+      state.m_paragraph.edit().m_propertyList.insert("fo:text-align", "end");
       break;
     default:
       STOFF_DEBUG_MSG(("StarPAttributeAdjust::addTo: unknown adjust %d\n", int(m_adjust)));
@@ -685,14 +685,14 @@ void StarPAttributeBulletNumeric::addTo(StarState &state, std::set<StarAttribute
       libstoff::appendUnicode(0x2022, bullet); // checkme
       level.m_propertyList.insert("text:bullet-char", bullet);
     }
-    state.m_paragraph.m_listLevel=level;
+    state.m_paragraph.edit().m_listLevel=level;
   }
 }
 
 void StarPAttributeBulletSimple::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==ATTR_EE_PARA_BULLET)
-    state.m_paragraph.m_listLevel=m_level;
+    state.m_paragraph.edit().m_listLevel=m_level;
 }
 
 void StarPAttributeDrop::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
@@ -704,7 +704,7 @@ void StarPAttributeDrop::addTo(StarState &state, std::set<StarAttribute const *>
     cap.insert("style:lines", m_numLines);
     librevenge::RVNGPropertyListVector capVector;
     capVector.append(cap);
-    state.m_paragraph.m_propertyList.insert("style:drop-cap", capVector);
+    state.m_paragraph.edit().m_propertyList.insert("style:drop-cap", capVector);
   }
 }
 
@@ -717,28 +717,28 @@ void StarPAttributeLineSpacing::addTo(StarState &state, std::set<StarAttribute c
   if (m_type==ATTR_PARA_LINESPACING) {
     // svx_paraitem.cxx SvxLineSpacingItem::QueryValue
     if (m_interLineSpaceRule==0)
-      state.m_paragraph.m_propertyList.insert("fo:line-height", "normal");
+      state.m_paragraph.edit().m_propertyList.insert("fo:line-height", "normal");
     switch (m_lineSpaceRule) {
     case 0: // will be set later
       break;
     case 1:
-      state.m_paragraph.m_propertyList.insert("fo:line-height", state.m_global->m_relativeUnit*double(m_lineHeight), librevenge::RVNG_POINT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:line-height", state.m_global->m_relativeUnit*double(m_lineHeight), librevenge::RVNG_POINT);
       return;
     case 2:
-      state.m_paragraph.m_propertyList.insert("fo:line-height-at-least", state.m_global->m_relativeUnit*double(m_lineHeight), librevenge::RVNG_POINT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:line-height-at-least", state.m_global->m_relativeUnit*double(m_lineHeight), librevenge::RVNG_POINT);
       return;
     default:
       STOFF_DEBUG_MSG(("StarPAttributeLineSpacing::addTo: unknown rule %d\n", int(m_lineSpaceRule)));
     }
     switch (m_interLineSpaceRule) {
     case 0: // off
-      state.m_paragraph.m_propertyList.insert("fo:line-height", 1., librevenge::RVNG_PERCENT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:line-height", 1., librevenge::RVNG_PERCENT);
       break;
     case 1: // Prop
-      state.m_paragraph.m_propertyList.insert("fo:line-height", double(m_propLineSpace)/100., librevenge::RVNG_PERCENT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:line-height", double(m_propLineSpace)/100., librevenge::RVNG_PERCENT);
       break;
     case 2: // Fix
-      state.m_paragraph.m_propertyList.insert("fo:line-height", state.m_global->m_relativeUnit*double(m_interLineSpace), librevenge::RVNG_POINT);
+      state.m_paragraph.edit().m_propertyList.insert("fo:line-height", state.m_global->m_relativeUnit*double(m_interLineSpace), librevenge::RVNG_POINT);
       break;
     default:
       STOFF_DEBUG_MSG(("StarPAttributeLineSpacing::addTo: unknown inter linse spacing rule %d\n", int(m_interLineSpaceRule)));
@@ -790,7 +790,7 @@ void StarPAttributeTabStop::addTo(StarState &state, std::set<StarAttribute const
     tab.insert("style:position", state.m_global->m_relativeUnit*double(tabStop.m_pos), librevenge::RVNG_POINT);
     tabs.append(tab);
   }
-  state.m_paragraph.m_propertyList.insert("style:tab-stops", tabs);
+  state.m_paragraph.edit().m_propertyList.insert("style:tab-stops", tabs);
 }
 
 bool StarPAttributeAdjust::read(StarZone &zone, int vers, long endPos, StarObject &/*object*/)
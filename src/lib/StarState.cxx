@@ -49,9 +49,20 @@ StarState::~StarState()
 {
 }
 
+void StarState::reinitialize()
+{
+  m_styleName="";
+  m_break=0;
+  m_cell.reset();
+  m_frame.reset();
+  m_graphic.reset();
+  m_paragraph.reset();
+  reinitializeLineData();
+}
+
 void StarState::reinitializeLineData()
 {
-  m_font=STOFFFont();
+  m_font.reset();
   m_content=m_footnote=false;
   m_link=m_refMark="";
   m_field.reset();
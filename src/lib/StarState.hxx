@@ -38,6 +38,7 @@
 #ifndef STAR_STATE_HXX
 #  define STAR_STATE_HXX
 
+#include <memory>
 #include <vector>
 
 #include "libstaroffice_internal.hxx"
@@ -66,6 +67,54 @@ struct Field;
 class StarState
 {
 public:
+  /** small class use to store a sub state: the data are shared between the
+      copies of a state and only copied when they are modified */
+  template <class T> class SubState
+  {
+  public:
+    //! constructor: uses the default value
+    SubState()
+      : m_data(getDefault())
+    {
+    }
+    //! assignment from a value
+    SubState &operator=(T const &value)
+    {
+      m_data=std::make_shared<T>(value);
+      return *this;
+    }
+    //! returns a read-only reference on the data
+    T const &get() const
+    {
+      return *m_data;
+    }
+    //! returns a reference on the data, copying them if they are shared
+    T &edit()
+    {
+      if (m_data.use_count()!=1)
+        m_data=std::make_shared<T>(*m_data);
+      return *m_data;
+    }
+    //! access to a read-only data, use edit to modify the data
+    T const *operator->() const
+    {
+      return m_data.get();
+    }
+    //! resets the data to the default value
+    void reset()
+    {
+      m_data=getDefault();
+    }
+  protected:
+    //! returns the shared default value
+    static std::shared_ptr<T> const &getDefault()
+    {
+      static std::shared_ptr<T> const defaultValue=std::make_shared<T>();
+      return defaultValue;
+    }
+    //! the data
+    std::shared_ptr<T> m_data;
+  };
   //! small struct use to store global data
   struct GlobalState {
     //! constructor
@@ -152,6 +201,8 @@ public:
   ~StarState();
   //! reinit the local data: break, font, content, footnote, ...
   void reinitializeLineData();
+  //! reinit all the local data: style name, break, styles, content, ... (but not the global state)
+  void reinitialize();
   //! global state
   std::shared_ptr<GlobalState> m_global;
   /// the style name
@@ -161,16 +212,16 @@ public:
   int m_break;
 
   /// the cell style
-  STOFFCellStyle m_cell;
+  SubState<STOFFCellStyle> m_cell;
   /// the frame style
-  STOFFFrameStyle m_frame;
+  SubState<STOFFFrameStyle> m_frame;
   /// the graphic style
-  STOFFGraphicStyle m_graphic;
+  SubState<STOFFGraphicStyle> m_graphic;
 
   /// the paragraph style
-  STOFFParagraph m_paragraph;
+  SubState<STOFFParagraph> m_paragraph;
   /// the font
-  STOFFFont m_font;
+  SubState<STOFFFont> m_font;
   /// flag to know if this is a content zone
   bool m_content;
   /// flag to know if this is a footnote
@@ -76,6 +76,8 @@ struct TableBox {
   bool read(Table &table, StarZone &zone, StarObjectText &object, STOFFBox2i &cPos);
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state) const;
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const;
   //! update the position to correspond to cover the m_position[0],right/bottom
   void updatePosition(Table &table, StarState const &state, float xOrigin, STOFFVec2i const &RBpos=STOFFVec2i(-1,-1));
   //! the position
@@ -109,6 +111,14 @@ struct TableLine {
   }
   //! try to read the data
   bool read(Table &table, StarZone &zone, StarObjectText &object, STOFFBox2i &cPos);
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const
+  {
+    for (auto const &box : m_boxList) {
+      if (box)
+        box->extractText(extractor, pool);
+    }
+  }
   //! update the position to correspond to cover the m_position[0],right/bottom
   void updatePosition(Table &table, StarState const &state, float xOrigin, STOFFVec2i const &RBpos=STOFFVec2i(-1,-1));
   //! the position
@@ -149,6 +159,14 @@ public:
   bool read(StarZone &zone, StarObjectText &object);
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state);
+  //! try to send only the text to a text extractor
+  void extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const
+  {
+    for (auto const &line : m_lineList) {
+      if (line)
+        line->extractText(extractor, pool);
+    }
+  }
 
   //! flag to know if the header is repeated
   bool m_headerRepeated;
@@ -189,9 +207,9 @@ void TableBox::updatePosition(Table &table, StarState const &state, float xOrigi
     }
   }
   if (m_format) {
-    cState.m_frame.m_frameSize=STOFFVec2i(0,0);
+    cState.m_frame.edit().m_frameSize=STOFFVec2i(0,0);
     m_format->updateState(cState);
-    if (cState.m_frame.m_frameSize[0]<=0) {
+    if (cState.m_frame->m_frameSize[0]<=0) {
       if (m_lineList.empty()) {
         static bool first=true;
         if (first) {
@@ -202,10 +220,10 @@ void TableBox::updatePosition(Table &table, StarState const &state, float xOrigi
       }
     }
     else {
-      m_xDimension=STOFFVec2f(xOrigin, xOrigin+cState.m_frame.m_frameSize[0]);
-      table.m_xPositionSet.insert(xOrigin+cState.m_frame.m_frameSize[0]);
-      if (cState.m_frame.m_frameSize[0] < table.m_minColWidth)
-        table.m_minColWidth=cState.m_frame.m_frameSize[0];
+      m_xDimension=STOFFVec2f(xOrigin, xOrigin+cState.m_frame->m_frameSize[0]);
+      table.m_xPositionSet.insert(xOrigin+cState.m_frame->m_frameSize[0]);
+      if (cState.m_frame->m_frameSize[0] < table.m_minColWidth)
+        table.m_minColWidth=cState.m_frame->m_frameSize[0];
     }
   }
   else if (m_lineList.empty()) {
@@ -221,8 +239,8 @@ void TableBox::updatePosition(Table &table, StarState const &state, float xOrigi
     if (table.m_rowToBoxMap.find(row)==table.m_rowToBoxMap.end())
       table.m_rowToBoxMap[row]=std::vector<StarTableInternal::TableBox *>();
     table.m_rowToBoxMap.find(row)->second.push_back(this);
-    m_cellStyle=cState.m_cell;
-    cState.m_frame.addTo(m_cellStyle.m_propertyList);
+    m_cellStyle=cState.m_cell.get();
+    cState.m_frame->addTo(m_cellStyle.m_propertyList);
     return;
   }
   for (size_t i=0; i< m_lineList.size(); ++i) {
@@ -340,6 +358,16 @@ bool TableBox::send(STOFFListenerPtr listener, StarState &state) const
   return true;
 }
 
+void TableBox::extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const
+{
+  if (m_content)
+    m_content->extractText(extractor, pool);
+  for (auto const &line : m_lineList) {
+    if (line)
+      line->extractText(extractor, pool);
+  }
+}
+
 void TableLine::updatePosition(Table &table, StarState const &state, float xOrigin, STOFFVec2i const &RBpos)
 {
   for (int i=0; i<2; ++i) {
@@ -588,17 +616,17 @@ bool StarTableInternal::Table::send(STOFFListenerPtr listener, StarState &state)
   STOFFTable table;
   if (m_format) {
     m_format->updateState(cState);
-    table.m_propertyList=cState.m_cell.m_propertyList;
-    cState.m_frame.addTo(table.m_propertyList);
+    table.m_propertyList=cState.m_cell->m_propertyList;
+    cState.m_frame->addTo(table.m_propertyList);
 
-    m_minColWidth=cState.m_frame.m_frameSize[0];
+    m_minColWidth=cState.m_frame->m_frameSize[0];
     // checkme sometime the width is 65535/20, ie. bigger than the page width...
-    if (cState.m_frame.m_frameSize[0]>=float(int(65535/20))) {
-      percentMaxValue=cState.m_frame.m_frameSize[0];
+    if (cState.m_frame->m_frameSize[0]>=float(int(65535/20))) {
+      percentMaxValue=cState.m_frame->m_frameSize[0];
       table.m_propertyList.insert("style:width", 1., librevenge::RVNG_PERCENT);
     }
-    else if (cState.m_frame.m_frameSize[0]>0)
-      table.m_propertyList.insert("style:width", double(cState.m_frame.m_frameSize[0]), librevenge::RVNG_POINT);
+    else if (cState.m_frame->m_frameSize[0]>0)
+      table.m_propertyList.insert("style:width", double(cState.m_frame->m_frameSize[0]), librevenge::RVNG_POINT);
   }
   m_xPositionSet.insert(0);
   for (auto line : m_lineList) {
@@ -677,4 +705,9 @@ bool StarTable::send(STOFFListenerPtr listener, StarState &state) const
   return m_table->send(listener, state);
 }
 
+void StarTable::extractText(STOFFTextExtractor &extractor, StarItemPool const *pool) const
+{
+  m_table->extractText(extractor, pool);
+}
+
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
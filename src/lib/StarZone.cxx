@@ -78,6 +78,21 @@ void StarZone::setInput(STOFFInputStreamPtr ip)
   m_ascii.setStream(ip);
 }
 
+void StarZone::copyStateFrom(StarZone const &zone)
+{
+  m_version=zone.m_version;
+  m_documentVersion=zone.m_documentVersion;
+  m_headerVersionStack=zone.m_headerVersionStack;
+  m_encoding=zone.m_encoding;
+  m_guiType=zone.m_guiType;
+  m_encryption=zone.m_encryption;
+  m_typeStack=zone.m_typeStack;
+  m_positionStack=zone.m_positionStack;
+  m_beginToEndMap=zone.m_beginToEndMap;
+  m_flagEndZone=zone.m_flagEndZone;
+  m_poolList=zone.m_poolList;
+}
+
 bool StarZone::readString(std::vector<uint32_t> &string, std::vector<size_t> &srcPositions, int encoding, bool chckEncryption) const
 {
   int sSz=int(m_input->readULong(2));
@@ -340,6 +355,7 @@ bool StarZone::readSWHeader()
 ////////////////////////////////////////////////////////////
 bool StarZone::openSCHHeader()
 {
+  libstoff::ParseGuard::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+6)) return false;
   // schiocmp.cxx: SchIOHeader::SchIOHeader
@@ -371,6 +387,7 @@ bool StarZone::closeSCHHeader(std::string const &debugName)
 
 bool StarZone::openVersionCompatHeader()
 {
+  libstoff::ParseGuard::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+6)) return false;
   // vcompat.cxx: VersionCompat::VersionCompat
@@ -402,6 +419,7 @@ bool StarZone::closeVersionCompatHeader(std::string const &debugName)
 
 bool StarZone::openSDRHeader(std::string &magic)
 {
+  libstoff::ParseGuard::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   // svdio.cxx: SdrIOHeader::Read
@@ -454,6 +472,7 @@ bool StarZone::openDummyRecord()
 
 bool StarZone::openRecord()
 {
+  libstoff::ParseGuard::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long sz=m_input->readULong(4);
@@ -482,6 +501,7 @@ bool StarZone::openRecord()
 
 bool StarZone::openSCRecord()
 {
+  libstoff::ParseGuard::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long sz=m_input->readULong(4);
@@ -506,6 +526,7 @@ bool StarZone::openSCRecord()
 
 bool StarZone::openSWRecord(char &type)
 {
+  libstoff::ParseGuard::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long val=m_input->readULong(4);
@@ -549,6 +570,7 @@ bool StarZone::openSWRecord(char &type)
 
 bool StarZone::openSfxRecord(char &type)
 {
+  libstoff::ParseGuard::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   // filerec.cxx SfxMiniRecordReader::SfxMiniRecordReader
@@ -250,6 +250,10 @@ public:
   }
   //! reset the current input
   void setInput(STOFFInputStreamPtr input);
+  /** copies the reading state of another zone: versions, encoding, encryption, pool names and opened records.
+
+      \note used to read a part of a zone with another input (in another thread) */
+  void copyStateFrom(StarZone const &zone);
   //! returns the ascii file
   libstoff::DebugFile &ascii()
   {
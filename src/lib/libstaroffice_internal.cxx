@@ -46,6 +46,8 @@
 
 #include "libstaroffice_internal.hxx"
 
+#include "STOFFInputStream.hxx"
+
 /** namespace used to regroup all libwpd functions, enumerations which we have redefined for internal usage */
 namespace libstoff
 {
@@ -78,7 +80,10 @@ librevenge::RVNGString getString(std::vector<uint32_t> const &unicode)
   return res;
 }
 
-void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
+namespace
+{
+//! writes the UTF-8 encoding of an unicode character in outbuf (which must have at least 6 characters), returns the number of bytes
+int encodeUnicode(uint32_t val, char *outbuf)
 {
   uint8_t first;
   int len;
@@ -107,16 +112,133 @@ void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
     len = 6;
   }
 
-  char outbuf[7];
-  int i;
-  for (i = len - 1; i > 0; --i) {
+  for (int i = len - 1; i > 0; --i) {
     outbuf[i] = char((val & 0x3f) | 0x80);
     val >>= 6;
   }
   outbuf[0] = char(val | first);
-  outbuf[len] = 0;
+  return len;
+}
+}
+
+void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
+{
+  char outbuf[7];
+  outbuf[encodeUnicode(val, outbuf)] = 0;
   buffer.append(outbuf);
 }
+
+bool appendUnicode(uint32_t const *characters, size_t num, std::string &run)
+{
+  if (!characters || !num) return false;
+  size_t const actSize=run.size();
+  run.reserve(actSize+num);
+  char outbuf[6];
+  for (size_t c=0; c<num; ++c) {
+    uint32_t val=characters[c];
+    if (val==0xfffd) continue;
+    if (val<0x20 && val!=0x9 && val!=0xa && val!=0xd) {
+      static int numErrors=0;
+      if (++numErrors<10) {
+        STOFF_DEBUG_MSG(("libstoff::appendUnicode: find odd char %x\n", static_cast<unsigned int>(val)));
+      }
+      continue;
+    }
+    if (val<0x80)
+      run+=char(val);
+    else
+      run.append(outbuf, size_t(encodeUnicode(val, outbuf)));
+  }
+  return run.size()!=actSize;
+}
+
+std::recursive_mutex &getInputMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+}
+
+// parse guard
+namespace libstoff
+{
+namespace
+{
+//! the guard of the current thread
+thread_local ParseGuard *s_currentGuard=nullptr;
+}
+
+ParseGuard::ParseGuard(double maxDuration, unsigned long maxAllocation, bool (*cancelCallback)(void *), void *cancelData)
+  : m_deadline()
+  , m_hasDeadline(maxDuration>0)
+  , m_maxAllocation(maxAllocation)
+  , m_cancelCallback(cancelCallback)
+  , m_cancelData(cancelData)
+  , m_numChecks(0)
+  , m_allocated(0)
+  , m_aborted(false)
+  , m_previous(s_currentGuard)
+{
+  if (m_hasDeadline)
+    m_deadline=std::chrono::steady_clock::now()+
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(maxDuration));
+  s_currentGuard=this;
+}
+
+ParseGuard::~ParseGuard()
+{
+  if (s_currentGuard==this)
+    s_currentGuard=m_previous;
+}
+
+ParseGuard *ParseGuard::getCurrent()
+{
+  return s_currentGuard;
+}
+
+void ParseGuard::setCurrent(ParseGuard *guard)
+{
+  s_currentGuard=guard;
+}
+
+void ParseGuard::abort()
+{
+  m_aborted=true;
+  throw AbortException();
+}
+
+void ParseGuard::check()
+{
+  auto *guard=s_currentGuard;
+  if (!guard) return;
+  if (guard->m_aborted) throw AbortException();
+  // reading the clock or calling the callback is slow, so only do it regularly
+  if ((++guard->m_numChecks & 0xff)!=0) return;
+  if (guard->m_hasDeadline && std::chrono::steady_clock::now()>guard->m_deadline) {
+    STOFF_DEBUG_MSG(("libstoff::ParseGuard::check: the deadline is reached\n"));
+    guard->abort();
+  }
+  if (guard->m_cancelCallback && guard->m_cancelCallback(guard->m_cancelData)) {
+    STOFF_DEBUG_MSG(("libstoff::ParseGuard::check: the parsing is cancelled\n"));
+    guard->abort();
+  }
+}
+
+void ParseGuard::checkAllocation(unsigned long num, size_t size)
+{
+  auto *guard=s_currentGuard;
+  if (!guard) return;
+  if (guard->m_aborted) throw AbortException();
+  if (!guard->m_maxAllocation) return;
+  if (size && num>guard->m_maxAllocation/size) {
+    STOFF_DEBUG_MSG(("libstoff::ParseGuard::checkAllocation: the allocation of %lu elements is too big\n", num));
+    guard->abort();
+  }
+  if ((guard->m_allocated+=num*size)>guard->m_maxAllocation) {
+    STOFF_DEBUG_MSG(("libstoff::ParseGuard::checkAllocation: the allocation budget is exhausted\n"));
+    guard->abort();
+  }
+}
 }
 
 namespace libstoff
@@ -294,13 +416,45 @@ STOFFEmbeddedObject::~STOFFEmbeddedObject()
 {
 }
 
+void STOFFEmbeddedObject::add(STOFFEmbeddedObject const &object)
+{
+  for (size_t i=0; i<object.size(); ++i) {
+    if (i<object.m_lazyDataList.size() && !object.m_lazyDataList[i].isEmpty()) {
+      auto const &lazy=object.m_lazyDataList[i];
+      addLazy(lazy.m_input, lazy.m_begin, lazy.m_end, object.getType(i));
+    }
+    else if (i<object.m_dataList.size() && !object.m_dataList[i].empty())
+      add(object.m_dataList[i], object.getType(i));
+  }
+}
+
+librevenge::RVNGBinaryData STOFFEmbeddedObject::getData(size_t id) const
+{
+  if (id<m_lazyDataList.size() && !m_lazyDataList[id].isEmpty()) {
+    auto const &lazy=m_lazyDataList[id];
+    std::lock_guard<std::recursive_mutex> lock(libstoff::getInputMutex());
+    librevenge::RVNGBinaryData data;
+    long actPos=lazy.m_input->tell();
+    if (lazy.m_input->seek(lazy.m_begin, librevenge::RVNG_SEEK_SET)!=0 || lazy.m_input->tell()!=lazy.m_begin ||
+        !lazy.m_input->readDataBlock(lazy.m_end-lazy.m_begin, data)) {
+      STOFF_DEBUG_MSG(("STOFFEmbeddedObject::getData: can not read the data\n"));
+      data.clear();
+    }
+    lazy.m_input->seek(actPos, librevenge::RVNG_SEEK_SET);
+    return data;
+  }
+  if (id<m_dataList.size())
+    return m_dataList[id];
+  return librevenge::RVNGBinaryData();
+}
+
 bool STOFFEmbeddedObject::addAsFillImageTo(librevenge::RVNGPropertyList &propList) const
 {
-  for (size_t i=0; i<m_dataList.size(); ++i) {
-    if (m_dataList[i].empty()) continue;
-    std::string type=m_typeList.size() ? m_typeList[i] : "image/pict";
-    propList.insert("librevenge:mime-type", type.c_str());
-    propList.insert("draw:fill-image", m_dataList[i].getBase64Data());
+  for (size_t i=0; i<size(); ++i) {
+    auto const data=getData(i);
+    if (data.empty()) continue;
+    propList.insert("librevenge:mime-type", getType(i).c_str());
+    propList.insert("draw:fill-image", data.getBase64Data());
     return true;
   }
   return false;
@@ -310,18 +464,19 @@ bool STOFFEmbeddedObject::addTo(librevenge::RVNGPropertyList &propList) const
 {
   bool firstSet=false;
   librevenge::RVNGPropertyListVector auxiliarVector;
-  for (size_t i=0; i<m_dataList.size(); ++i) {
-    if (m_dataList[i].empty()) continue;
-    std::string type=m_typeList.size() ? m_typeList[i] : "image/pict";
+  for (size_t i=0; i<size(); ++i) {
+    auto const data=getData(i);
+    if (data.empty()) continue;
+    std::string type=getType(i);
     if (!firstSet) {
       propList.insert("librevenge:mime-type", type.c_str());
-      propList.insert("office:binary-data", m_dataList[i]);
+      propList.insert("office:binary-data", data);
       firstSet=true;
       continue;
     }
     librevenge::RVNGPropertyList auxiList;
     auxiList.insert("librevenge:mime-type", type.c_str());
-    auxiList.insert("office:binary-data", m_dataList[i]);
+    auxiList.insert("office:binary-data", data);
     auxiliarVector.append(auxiList);
   }
   if (!m_filenameLink.empty()) {
@@ -352,6 +507,15 @@ int STOFFEmbeddedObject::cmp(STOFFEmbeddedObject const &pict) const
     if (m_typeList[i]<pict.m_typeList[i]) return -1;
     if (m_typeList[i]>pict.m_typeList[i]) return 1;
   }
+  if (m_lazyDataList.size()!=pict.m_lazyDataList.size())
+    return m_lazyDataList.size()<pict.m_lazyDataList.size() ? -1 : 1;
+  for (size_t i=0; i<m_lazyDataList.size(); ++i) {
+    auto const &lazy=m_lazyDataList[i];
+    auto const &aLazy=pict.m_lazyDataList[i];
+    if (lazy.m_input.get()!=aLazy.m_input.get()) return lazy.m_input.get()<aLazy.m_input.get() ? -1 : 1;
+    if (lazy.m_begin!=aLazy.m_begin) return lazy.m_begin<aLazy.m_begin ? -1 : 1;
+    if (lazy.m_end!=aLazy.m_end) return lazy.m_end<aLazy.m_end ? -1 : 1;
+  }
   if (m_dataList.size()!=pict.m_dataList.size())
     return m_dataList.size()<pict.m_dataList.size() ? -1 : 1;
   for (size_t i=0; i<m_dataList.size(); ++i) {
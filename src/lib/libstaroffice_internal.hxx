@@ -40,9 +40,13 @@
 #include <stdio.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -150,6 +154,61 @@ class GenericException
 class WrongPasswordException
 {
 };
+
+//! exception thrown when a parsing must be stopped: deadline, allocation budget, cancellation
+class AbortException
+{
+};
+
+/** class used to check the limits of a parsing: the deadline, the maximal allocated size and the cancellation.
+
+    The guard is associated to the thread which creates it, the threads created during the parsing
+    must call setCurrent to use the same guard. */
+class ParseGuard
+{
+public:
+  //! constructor: maxDuration in second, maxAllocation in bytes (0 means no limit)
+  ParseGuard(double maxDuration, unsigned long maxAllocation, bool (*cancelCallback)(void *), void *cancelData);
+  //! destructor
+  ~ParseGuard();
+  //! returns true if the parsing has been aborted
+  bool isAborted() const
+  {
+    return m_aborted;
+  }
+  //! returns the guard of the current thread (if any)
+  static ParseGuard *getCurrent();
+  //! sets the guard of the current thread
+  static void setCurrent(ParseGuard *guard);
+  //! checks the current guard's deadline and cancellation, throws an AbortException if the parsing must stop
+  static void check();
+  //! adds num*size bytes to the current guard's allocated size, throws an AbortException if the parsing must stop
+  static void checkAllocation(unsigned long num, size_t size);
+protected:
+  //! sets the aborted flag and throws an AbortException
+  void abort();
+  //! the deadline (if m_hasDeadline is set)
+  std::chrono::steady_clock::time_point m_deadline;
+  //! a flag to know if a deadline is set
+  bool m_hasDeadline;
+  //! the maximal allocated size (0 means no limit)
+  unsigned long m_maxAllocation;
+  //! the cancel callback
+  bool (*m_cancelCallback)(void *);
+  //! the cancel callback data
+  void *m_cancelData;
+  //! the number of check calls
+  std::atomic<unsigned> m_numChecks;
+  //! the current allocated size
+  std::atomic<unsigned long> m_allocated;
+  //! a flag to know if the parsing is aborted
+  std::atomic<bool> m_aborted;
+  //! the previous guard of the creating thread
+  ParseGuard *m_previous;
+private:
+  ParseGuard(ParseGuard const &orig) = delete;
+  ParseGuard &operator=(ParseGuard const &orig) = delete;
+};
 }
 
 /* ---------- input ----------------- */
@@ -158,8 +217,15 @@ namespace libstoff
 uint8_t readU8(librevenge::RVNGInputStream *input);
 //! adds an unicode character to a string
 void appendUnicode(uint32_t val, librevenge::RVNGString &buffer);
+/** adds the UTF-8 encoding of a run of unicode characters to a string: the undef characters (0xfffd)
+    and the control characters (excepted 0x9, 0xa and 0xd) are ignored.
+
+    \return false if no character is added */
+bool appendUnicode(uint32_t const *characters, size_t num, std::string &buffer);
 //! transform a unicode string in a RNVGString
 librevenge::RVNGString getString(std::vector<uint32_t> const &unicode);
+//! returns the mutex to lock when reading a shared input while the pages are sent in different threads
+std::recursive_mutex &getInputMutex();
 }
 
 /* ---------- small enum/class ------------- */
@@ -392,18 +458,38 @@ struct STOFFNote {
   int m_number;
 };
 
+class STOFFInputStream;
+
 /** small class use to define a embedded object
 
     \note mainly used to store picture
  */
 struct STOFFEmbeddedObject {
+  //! a representation whose data are still stored in an input stream
+  struct LazyData {
+    //! constructor
+    LazyData() : m_input(), m_begin(0), m_end(0)
+    {
+    }
+    //! returns true if no data are stored
+    bool isEmpty() const
+    {
+      return !m_input || m_end<=m_begin;
+    }
+    //! the input
+    std::shared_ptr<STOFFInputStream> m_input;
+    //! the first data position
+    long m_begin;
+    //! the end data position
+    long m_end;
+  };
   //! empty constructor
-  STOFFEmbeddedObject() : m_dataList(), m_typeList(),  m_filenameLink("")
+  STOFFEmbeddedObject() : m_dataList(), m_typeList(), m_lazyDataList(), m_filenameLink("")
   {
   }
   //! constructor
   STOFFEmbeddedObject(librevenge::RVNGBinaryData const &binaryData,
-                      std::string type="image/pict") : m_dataList(), m_typeList(), m_filenameLink("")
+                      std::string type="image/pict") : m_dataList(), m_typeList(), m_lazyDataList(), m_filenameLink("")
   {
     add(binaryData, type);
   }
@@ -418,18 +504,49 @@ struct STOFFEmbeddedObject {
       if (!m_dataList[i].empty())
         return false;
     }
+    for (auto const &lazy : m_lazyDataList) {
+      if (!lazy.isEmpty())
+        return false;
+    }
     return true;
   }
+  //! returns the number of representations
+  size_t size() const
+  {
+    return std::max(m_dataList.size(), std::max(m_typeList.size(), m_lazyDataList.size()));
+  }
   //! add a picture
   void add(librevenge::RVNGBinaryData const &binaryData, std::string type="image/pict")
   {
-    size_t pos=m_dataList.size();
-    if (pos<m_typeList.size()) pos=m_typeList.size();
+    size_t pos=size();
     m_dataList.resize(pos+1);
     m_dataList[pos]=binaryData;
     m_typeList.resize(pos+1);
     m_typeList[pos]=type;
   }
+  /** add a picture stored in input between begin and end
+
+      \note the data are only read when they are sent */
+  void addLazy(std::shared_ptr<STOFFInputStream> input, long begin, long end, std::string type="image/pict")
+  {
+    size_t pos=size();
+    m_dataList.resize(pos+1);
+    m_typeList.resize(pos+1);
+    m_typeList[pos]=type;
+    m_lazyDataList.resize(pos+1);
+    m_lazyDataList[pos].m_input=input;
+    m_lazyDataList[pos].m_begin=begin;
+    m_lazyDataList[pos].m_end=end;
+  }
+  //! add the non empty representations of another object
+  void add(STOFFEmbeddedObject const &object);
+  //! returns the data of the id^th representation, reading them if needed
+  librevenge::RVNGBinaryData getData(size_t id) const;
+  //! returns the type of the id^th representation
+  std::string getType(size_t id) const
+  {
+    return id<m_typeList.size() ? m_typeList[id] : "image/pict";
+  }
   /** add the link property to proplist */
   bool addTo(librevenge::RVNGPropertyList &propList) const;
   /** add the link property to a graph style as bitmap */
@@ -443,6 +560,8 @@ struct STOFFEmbeddedObject {
   std::vector<librevenge::RVNGBinaryData> m_dataList;
   //! the picture type: one type by representation
   std::vector<std::string> m_typeList;
+  //! the representations which are not read: one by representation
+  std::vector<LazyData> m_lazyDataList;
   //! a picture link
   librevenge::RVNGString m_filenameLink;
 };
@@ -468,6 +587,7 @@ class STOFFListManager;
 class STOFFParserState;
 class STOFFSpreadsheetListener;
 class STOFFSubDocument;
+class STOFFTextExtractor;
 class STOFFTextListener;
 //! a smart pointer of STOFFGraphicListener
 typedef std::shared_ptr<STOFFGraphicListener> STOFFGraphicListenerPtr;